@@ -40,6 +40,8 @@
  #define _RAISONANCE_
 #elif defined(__ICCSTM8__)
  #define _IAR_
+#elif defined(__SDCC__)
+ #define _SDCC_
 #else
  #error "Unsupported Compiler!"          /* Compiler defines not found */
 #endif
@@ -64,6 +66,12 @@
  #define EEPROM eeprom
  #define CONST  code
  #define MEMCPY memcpy /*!< Used with memory Models for code less than 64K */
+#elif defined(_SDCC_)
+ #define FAR __far
+ #define NEAR __near
+ #define TINY __tiny
+ #define EEPROM __eeprom
+ #define CONST const
 #else /* _IAR_ */
  #define FAR  __far
  #define NEAR __near
@@ -90,6 +98,10 @@
    #define IN_RAM(a) a
  #elif defined (_RAISONANCE_) /* __RCST7__ */
    #define IN_RAM(a) a inram
+ #elif defined (_SDCC_)
+   /* SDCC selects the code segment per translation unit: RAM functions are
+      built into the RAM_SEG segment and copied to RAM at startup (stm8_ram.h) */
+   #define IN_RAM(a) a
  #else /*_IAR_*/
   #define IN_RAM(a) __ramfunc a
  #endif /* _COSMIC_ */
@@ -1329,6 +1341,16 @@ USART_TypeDef;
  #define wfi()               {_asm("wfi\n");}  /*!< Wait For Interrupt */
  #define wfe()               {_asm("wfe\n");}  /*!< Wait for event */
  #define halt()              {_asm("halt\n");} /*!< Halt */
+#elif defined(_SDCC_)
+ #define enableInterrupts()  {__asm rim __endasm;}  /*!< Enable interrupts */
+ #define disableInterrupts() {__asm sim __endasm;}  /*!< Disable interrupts */
+ #define rim()               {__asm rim __endasm;}  /*!< Enable interrupts */
+ #define sim()               {__asm sim __endasm;}  /*!< Disable interrupts */
+ #define nop()               {__asm nop __endasm;}  /*!< No Operation */
+ #define trap()              {__asm trap __endasm;} /*!< Trap (soft IT) */
+ #define wfi()               {__asm wfi __endasm;}  /*!< Wait For Interrupt */
+ #define wfe()               {__asm wfe __endasm;}  /*!< Wait for event */
+ #define halt()              {__asm halt __endasm;} /*!< Halt */
 #else /* _IAR */
  #include <intrinsics.h>
  #define enableInterrupts()  __enable_interrupt()   /*!< Enable interrupts */
@@ -1365,6 +1387,11 @@ USART_TypeDef;
   __interrupt void (a) (void)
 #endif
 
+#ifdef _SDCC_
+#define INTERRUPT_HANDLER(a,b) void a(void) __interrupt(b)
+#define INTERRUPT_HANDLER_TRAP(a) void a(void) __trap
+#endif
+
 /*============================== Interrupt Handler declaration ========================*/
 
 #ifdef _COSMIC_
@@ -159,6 +159,10 @@ typedef enum
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
+/* USARTDIV for USART_InitDivider(): CLOCK (fMASTER, Hz) / BAUDRATE rounded,
+   constant folded when both are constants */
+#define USART_BAUD_DIVIDER(CLOCK, BAUDRATE) \
+  ((uint16_t)(((uint32_t)(CLOCK) + ((uint32_t)(BAUDRATE) / 2)) / (uint32_t)(BAUDRATE)))
 /* Private macros ------------------------------------------------------------*/
 
 /** @addtogroup USART_Private_Macros
@@ -269,6 +273,7 @@ typedef enum
 
 /* BaudRate value should be < 625000 bps */
 #define IS_USART_BAUDRATE(NUM) ((NUM) <= (uint32_t)625000)
+#define IS_USART_BAUDDIVIDER(NUM) ((NUM) >= (uint16_t)16)
 
 /**
  * @brief Macro used by the assert function in order to check the different sensitivity values
@@ -296,6 +301,8 @@ typedef enum
 void USART_DeInit(void);
 void USART_Init(uint32_t BaudRate, USART_WordLength_TypeDef USART_WordLength, USART_StopBits_TypeDef
                 USART_StopBits, USART_Parity_TypeDef USART_Parity, USART_Mode_TypeDef USART_Mode);
+void USART_InitDivider(uint16_t BaudDivider, USART_WordLength_TypeDef USART_WordLength, USART_StopBits_TypeDef
+                       USART_StopBits, USART_Parity_TypeDef USART_Parity, USART_Mode_TypeDef USART_Mode);
 void USART_ClockInit(USART_Clock_TypeDef USART_Clock, USART_CPOL_TypeDef USART_CPOL,
                      USART_CPHA_TypeDef USART_CPHA, USART_LastBit_TypeDef USART_LastBit);
 void USART_Cmd(FunctionalState NewState);
@@ -115,6 +115,22 @@
 #define FLASH_CLEAR_BYTE   ((uint8_t)0x00);
 #define FLASH_SET_BYTE     ((uint8_t)0xFF);
 #define OPERATION_TIMEOUT  ((uint16_t)0x1000)
+
+/* SDCC selects the code segment per translation unit: with RAM_EXECUTION this
+   file is compiled twice, the RAM_SEG_BUILD pass holding only the functions
+   to be executed from RAM */
+#if defined (_SDCC_) && defined (RAM_EXECUTION)
+ #if defined (RAM_SEG_BUILD)
+  #define FLASH_ROM_FUNCTIONS  0
+  #define FLASH_RAM_FUNCTIONS  1
+ #else
+  #define FLASH_ROM_FUNCTIONS  1
+  #define FLASH_RAM_FUNCTIONS  0
+ #endif /* RAM_SEG_BUILD */
+#else
+ #define FLASH_ROM_FUNCTIONS  1
+ #define FLASH_RAM_FUNCTIONS  1
+#endif /* _SDCC_ && RAM_EXECUTION */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private Constants ---------------------------------------------------------*/
@@ -125,6 +141,8 @@
   * @{
   */ 
 
+#if FLASH_ROM_FUNCTIONS
+
 /** @defgroup FLASH_Group1 FLASH program and Data EEPROM memories Interface 
   *                        configuration functions
   *  @brief   FLASH Interface configuration functions 
@@ -488,6 +506,10 @@ FlagStatus FLASH_GetFlagStatus(FLASH_FLAG_TypeDef FLASH_FLAG)
   * @}
   */ 
   
+#endif /* FLASH_ROM_FUNCTIONS */
+
+#if FLASH_RAM_FUNCTIONS
+
 /** @defgroup FLASH_Group5 Functions to be executed from RAM
  *  @brief  Functions to be executed from RAM
  *
@@ -500,6 +522,15 @@ FlagStatus FLASH_GetFlagStatus(FLASH_FLAG_TypeDef FLASH_FLAG)
  for the FLASH_WaitForLastOperation function which can be executed from Flash.
 
  Steps of the execution from RAM differs from one toolchain to another:
+ - For SDCC Compiler:
+    1- Define RAM_EXECUTION for the whole target, e.g. with STM8_ADD_RAM_SEGMENT
+    and STM8_SET_RAM_SEGMENT_PROPERTIES from sdcc-stm8.cmake.
+    2- This file is then compiled a second time with RAM_SEG_BUILD defined and
+    "--codeseg RAM_SEG", the RAM_SEG segment is linked at its RAM address and
+    its image is moved to the end of the Flash in the .ihx file.
+    3- The segment is copied from Flash to RAM by __sdcc_external_startup()
+    (stm8_ram.c) before main(), or by calling RAM_SEG_Load() explicitly.
+
  - For Cosmic Compiler:
   1- Define a segment FLASH_CODE by the mean of " #pragma section (FLASH_CODE)".
     This segment is defined in the stm8l10x_flash.c file.
@@ -692,6 +723,8 @@ IN_RAM(FLASH_Status_TypeDef FLASH_WaitForLastOperation(void))
  #pragma section ()
 #endif /* _COSMIC_ && RAM_EXECUTION */
 
+#endif /* FLASH_RAM_FUNCTIONS */
+
 /**
   * @}
   */
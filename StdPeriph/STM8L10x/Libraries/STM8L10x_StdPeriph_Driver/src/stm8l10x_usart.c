@@ -106,6 +106,46 @@ void USART_Init(uint32_t BaudRate, USART_WordLength_TypeDef USART_WordLength,
   /* Check the parameters */
   assert_param(IS_USART_BAUDRATE(BaudRate));
 
+  BaudRate_Mantissa  = ((uint32_t)CLK_GetClockFreq() / BaudRate);
+  USART_InitDivider((uint16_t)BaudRate_Mantissa,
+                    USART_WordLength, USART_StopBits, USART_Parity, USART_Mode);
+}
+
+/**
+  * @brief  Initializes the USART with a constant baud rate divider.
+  * @note   USART_BAUD_DIVIDER() folds the divider at compile time, so
+  *         CLK_GetClockFreq() and the 32-bit division of USART_Init()
+  *         are not linked.
+  * @note   Configure in Push Pull or Open Drain mode the Tx pin by setting the
+  *         correct I/O Port register according the product package and line
+  *         configuration
+  * @param  BaudDivider: USARTDIV, fMASTER / baud rate.
+  * @param  USART_WordLength: the word length
+  *           This parameter can be one of the following values:
+  *            @arg USART_WordLength_8D: 8 bits Data
+  *            @arg USART_WordLength_9D: 9 bits Data  
+  * @param  USART_StopBits: Stop Bit
+  *           This parameter can be one of the following values:
+  *            @arg USART_StopBits_1: One stop bit is transmitted at the end of frame
+  *            @arg USART_StopBits_2: Two stop bits are transmitted at the end of frame
+  * @param  USART_Parity: Parity
+  *           This parameter can be one of the following values:
+  *            @arg USART_Parity_No: No Parity
+  *            @arg USART_Parity_Even: Even Parity
+  *            @arg USART_Parity_Odd: Odd Parity   
+  * @param  USART_Mode: Mode
+  *           This parameter can be one of the following values:
+  *            @arg USART_Mode_Rx: Receive Enable
+  *            @arg USART_Mode_Tx: Transmit Enable 
+  * @retval None
+  */
+void USART_InitDivider(uint16_t BaudDivider, USART_WordLength_TypeDef USART_WordLength,
+                       USART_StopBits_TypeDef USART_StopBits, USART_Parity_TypeDef
+                       USART_Parity, USART_Mode_TypeDef USART_Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_USART_BAUDDIVIDER(BaudDivider));
+
   assert_param(IS_USART_WordLength(USART_WordLength));
 
   assert_param(IS_USART_STOPBITS(USART_StopBits));
@@ -132,13 +172,10 @@ void USART_Init(uint32_t BaudRate, USART_WordLength_TypeDef USART_WordLength,
   /* Clear the Fraction bits of USARTDIV */
   USART->BRR2 &= (uint8_t)(~USART_BRR2_DIVF);
 
-  BaudRate_Mantissa  = ((uint32_t)CLK_GetClockFreq() / BaudRate);
-  /* Set the fraction of USARTDIV */
-  USART->BRR2 = (uint8_t)((BaudRate_Mantissa >> (uint8_t)8) & (uint8_t)0xF0);
-  /* Set the MSB mantissa of USARTDIV */
-  USART->BRR2 |= (uint8_t)(BaudRate_Mantissa & (uint8_t)0x0F);
-  /* Set the LSB mantissa of USARTDIV */
-  USART->BRR1 = (uint8_t)(BaudRate_Mantissa >> (uint8_t)4);
+  /* Set the fraction and MSB mantissa of USARTDIV in one step, then its LSB mantissa */
+  USART->BRR2 = (uint8_t)((uint8_t)((uint8_t)(BaudDivider >> 8) & (uint8_t)0xF0) |
+                          (uint8_t)((uint8_t)BaudDivider & (uint8_t)0x0F));
+  USART->BRR1 = (uint8_t)(BaudDivider >> 4);
 
   /* Disable the Transmitter and Receiver */
   USART->CR2 &= (uint8_t)~(USART_CR2_TEN | USART_CR2_REN);
@@ -190,6 +190,10 @@ defined (STM8L05X_LD_VL) || defined (STM8L05X_MD_VL) || defined (STM8AL31_L_MD)
    #define IN_RAM(a) a
  #elif defined (_RAISONANCE_) /* __RCSTM8__ */
    #define IN_RAM(a) a inram
+ #elif defined (_SDCC_)
+   /* SDCC selects the code segment per translation unit: RAM functions are
+      built into the RAM_SEG segment and copied to RAM at startup (stm8_ram.h) */
+   #define IN_RAM(a) a
  #else /*_IAR_*/
   #define IN_RAM(a) __ramfunc a
  #endif /* _COSMIC_ */
@@ -311,11 +311,16 @@ typedef enum
   
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
+/* USARTDIV for USART_InitDivider(): CLOCK (fMASTER, Hz) / BAUDRATE rounded,
+   constant folded when both are constants */
+#define USART_BAUD_DIVIDER(CLOCK, BAUDRATE) \
+  ((uint16_t)(((uint32_t)(CLOCK) + ((uint32_t)(BAUDRATE) / 2)) / (uint32_t)(BAUDRATE)))
 /** @defgroupUSART_Exported_Macros
   * @{
   */
 /* BaudRate value should be < 625000 bps */
 #define IS_USART_BAUDRATE(NUM) ((NUM) <= (uint32_t)625000)
+#define IS_USART_BAUDDIVIDER(NUM) ((NUM) >= (uint16_t)16)
 
 #define USART_ADDRESS_MAX ((uint8_t)16)
 #define IS_USART_ADDRESS(address) ((address) < USART_ADDRESS_MAX)
@@ -336,6 +341,9 @@ void USART_DeInit(USART_TypeDef* USARTx);
 void USART_Init(USART_TypeDef* USARTx, uint32_t BaudRate, USART_WordLength_TypeDef
                 USART_WordLength, USART_StopBits_TypeDef USART_StopBits,
                 USART_Parity_TypeDef USART_Parity, USART_Mode_TypeDef USART_Mode);
+void USART_InitDivider(USART_TypeDef* USARTx, uint16_t BaudDivider, USART_WordLength_TypeDef
+                       USART_WordLength, USART_StopBits_TypeDef USART_StopBits,
+                       USART_Parity_TypeDef USART_Parity, USART_Mode_TypeDef USART_Mode);
 void USART_ClockInit(USART_TypeDef* USARTx, USART_Clock_TypeDef USART_Clock,
                      USART_CPOL_TypeDef USART_CPOL, USART_CPHA_TypeDef USART_CPHA,
                      USART_LastBit_TypeDef USART_LastBit);
@@ -84,6 +84,8 @@
  #define _RAISONANCE_
 #elif defined(__ICCSTM8__)
  #define _IAR_
+#elif defined(__SDCC__)
+ #define _SDCC_
 #else
  #error "Unsupported Compiler!"          /* Compiler defines not found */
 #endif
@@ -137,6 +139,12 @@
   /*!< Used with memory Models for code less than 64K */
   #define MEMCPY memcpy
  #endif /* STM8S208 or STM8S207 or STM8S007 or STM8AF62Ax or STM8AF52Ax */ 
+#elif defined(_SDCC_)
+ #define FAR __far
+ #define NEAR __near
+ #define TINY __tiny
+ #define EEPROM __eeprom
+ #define CONST const
 #else /*_IAR_*/
  #define FAR  __far
  #define NEAR __near
@@ -170,6 +178,10 @@
    #define IN_RAM(a) a
  #elif defined (_RAISONANCE_) /* __RCST7__ */
    #define IN_RAM(a) a inram
+ #elif defined (_SDCC_)
+   /* SDCC selects the code segment per translation unit: RAM functions are
+      built into the RAM_SEG segment and copied to RAM at startup (stm8_ram.h) */
+   #define IN_RAM(a) a
  #else /*_IAR_*/
   #define IN_RAM(a) __ramfunc a
  #endif /* _COSMIC_ */
@@ -2729,6 +2741,15 @@ CFG_TypeDef;
  #define trap()                {_asm("trap\n");} /* Trap (soft IT) */
  #define wfi()                 {_asm("wfi\n");}  /* Wait For Interrupt */
  #define halt()                {_asm("halt\n");} /* Halt */
+#elif defined(_SDCC_)
+ #define enableInterrupts()    {__asm rim __endasm;}  /* enable interrupts */
+ #define disableInterrupts()   {__asm sim __endasm;}  /* disable interrupts */
+ #define rim()                 {__asm rim __endasm;}  /* enable interrupts */
+ #define sim()                 {__asm sim __endasm;}  /* disable interrupts */
+ #define nop()                 {__asm nop __endasm;}  /* No Operation */
+ #define trap()                {__asm trap __endasm;} /* Trap (soft IT) */
+ #define wfi()                 {__asm wfi __endasm;}  /* Wait For Interrupt */
+ #define halt()                {__asm halt __endasm;} /* Halt */
 #else /*_IAR_*/
  #include <intrinsics.h>
  #define enableInterrupts()    __enable_interrupt()   /* enable interrupts */
@@ -2764,6 +2785,11 @@ CFG_TypeDef;
  __interrupt void (a) (void)  
 #endif /* _IAR_ */
 
+#ifdef _SDCC_
+ #define INTERRUPT_HANDLER(a,b) void a(void) __interrupt(b)
+ #define INTERRUPT_HANDLER_TRAP(a) void a(void) __trap
+#endif /* _SDCC_ */
+
 /*============================== Interrupt Handler declaration ========================*/
 #ifdef _COSMIC_
  #define INTERRUPT @far @interrupt
@@ -289,6 +289,11 @@ typedef enum
   */
 #define IS_ADC1_BUFFER_OK(BUFFER) ((BUFFER) <= (uint8_t)0x09)
 
+/**
+  * @brief  Macro used by the assert function to check the possible buffer counts.
+  */
+#define IS_ADC1_BUFFER_COUNT_OK(COUNT) (((COUNT) >= (uint8_t)1) && ((COUNT) <= (uint8_t)10))
+
 /**
   * @}
   */
@@ -323,6 +328,7 @@ uint16_t ADC1_GetConversionValue(void);
 void ADC1_SetHighThreshold(uint16_t Threshold);
 void ADC1_SetLowThreshold(uint16_t Threshold);
 uint16_t ADC1_GetBufferValue(uint8_t Buffer);
+void ADC1_GetBufferValues(uint16_t* Buffer, uint8_t Count);
 FlagStatus ADC1_GetAWDChannelStatus(ADC1_Channel_TypeDef Channel);
 FlagStatus ADC1_GetFlagStatus(ADC1_Flag_TypeDef Flag);
 void ADC1_ClearFlag(ADC1_Flag_TypeDef Flag);
@@ -84,6 +84,13 @@
   * @{
   */
 
+/**
+  * @brief  FLASH byte and word address: 16-bit on devices without memory above
+  *         64 KB, where the address pushed and the pointer arithmetic of a
+  *         32-bit address are wasted (see MemoryAddressCast in stm8s.h)
+  */
+typedef MemoryAddressCast FLASH_Address_TypeDef;
+
 /**
   * @brief  FLASH Memory types
   */
@@ -175,9 +182,15 @@ typedef enum {
 
 /**
   * @brief  Macro used by the assert function in order to check the different sensitivity values for the data eeprom and flash program Address
+  *         On STM8S105/005 the 16-bit FLASH_Address_TypeDef can't exceed the program memory end (0xFFFF)
   */
+#if defined(STM8S105) || defined(STM8S005) || defined(STM8AF626x)
+#define IS_FLASH_ADDRESS_OK(ADDRESS)(((ADDRESS) >= FLASH_PROG_START_PHYSICAL_ADDRESS) || \
+                                     (((ADDRESS) >= FLASH_DATA_START_PHYSICAL_ADDRESS) && ((ADDRESS) <= FLASH_DATA_END_PHYSICAL_ADDRESS)))
+#else
 #define IS_FLASH_ADDRESS_OK(ADDRESS)((((ADDRESS) >= FLASH_PROG_START_PHYSICAL_ADDRESS) && ((ADDRESS) <= FLASH_PROG_END_PHYSICAL_ADDRESS)) || \
                                      (((ADDRESS) >= FLASH_DATA_START_PHYSICAL_ADDRESS) && ((ADDRESS) <= FLASH_DATA_END_PHYSICAL_ADDRESS)))
+#endif /* STM8S105 or STM8S005 or STM8AF626x */
 
 /**
   * @brief  Macro used by the assert function in order to check the different sensitivity values for the flash program Block number
@@ -257,10 +270,10 @@ void FLASH_Unlock(FLASH_MemType_TypeDef FLASH_MemType);
 void FLASH_Lock(FLASH_MemType_TypeDef FLASH_MemType);
 void FLASH_DeInit(void);
 void FLASH_ITConfig(FunctionalState NewState);
-void FLASH_EraseByte(uint32_t Address);
-void FLASH_ProgramByte(uint32_t Address, uint8_t Data);
-uint8_t FLASH_ReadByte(uint32_t Address);
-void FLASH_ProgramWord(uint32_t Address, uint32_t Data);
+void FLASH_EraseByte(FLASH_Address_TypeDef Address);
+void FLASH_ProgramByte(FLASH_Address_TypeDef Address, uint8_t Data);
+uint8_t FLASH_ReadByte(FLASH_Address_TypeDef Address);
+void FLASH_ProgramWord(FLASH_Address_TypeDef Address, uint32_t Data);
 uint16_t FLASH_ReadOptionByte(uint16_t Address);
 void FLASH_ProgramOptionByte(uint16_t Address, uint8_t Data);
 void FLASH_EraseOptionByte(uint16_t Address);
@@ -171,6 +171,10 @@ typedef enum { UART1_IT_TXE        = (uint16_t)0x0277, /*!< Transmit interrupt *
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros ------------------------------------------------------------*/
+/* UART1DIV for UART1_InitDivider(): CLOCK (fMASTER, Hz) / BAUDRATE rounded,
+   constant folded when both are constants */
+#define UART1_BAUD_DIVIDER(CLOCK, BAUDRATE) \
+  ((uint16_t)(((uint32_t)(CLOCK) + ((uint32_t)(BAUDRATE) / 2)) / (uint32_t)(BAUDRATE)))
 
 /* Private macros ------------------------------------------------------------*/
 
@@ -323,6 +327,7 @@ typedef enum { UART1_IT_TXE        = (uint16_t)0x0277, /*!< Transmit interrupt *
  *        baudrate value
  */
 #define IS_UART1_BAUDRATE_OK(NUM) ((NUM) <= (uint32_t)625000)
+#define IS_UART1_BAUDDIVIDER_OK(NUM) ((NUM) >= (uint16_t)16)
 
 
 /**
@@ -346,6 +351,9 @@ void UART1_DeInit(void);
 void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength, 
                 UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
                 UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode);
+void UART1_InitDivider(uint16_t BaudDivider, UART1_WordLength_TypeDef WordLength, 
+                       UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
+                       UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode);
 void UART1_Cmd(FunctionalState NewState);
 void UART1_ITConfig(UART1_IT_TypeDef UART1_IT, FunctionalState NewState);
 void UART1_HalfDuplexCmd(FunctionalState NewState);
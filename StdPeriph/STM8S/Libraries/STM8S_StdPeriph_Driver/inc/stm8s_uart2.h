@@ -199,6 +199,10 @@ typedef enum { UART2_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros ------------------------------------------------------------*/
+/* UART2DIV for UART2_InitDivider(): CLOCK (fMASTER, Hz) / BAUDRATE rounded,
+   constant folded when both are constants */
+#define UART2_BAUD_DIVIDER(CLOCK, BAUDRATE) \
+  ((uint16_t)(((uint32_t)(CLOCK) + ((uint32_t)(BAUDRATE) / 2)) / (uint32_t)(BAUDRATE)))
 
 /* Private macros ------------------------------------------------------------*/
 
@@ -359,6 +363,7 @@ typedef enum { UART2_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
  *        baudrate value
  */
 #define IS_UART2_BAUDRATE_OK(NUM) ((NUM) <= (uint32_t)625000)
+#define IS_UART2_BAUDDIVIDER_OK(NUM) ((NUM) >= (uint16_t)16)
 
 
 /**
@@ -405,6 +410,9 @@ void UART2_DeInit(void);
 void UART2_Init(uint32_t BaudRate, UART2_WordLength_TypeDef WordLength, 
                 UART2_StopBits_TypeDef StopBits, UART2_Parity_TypeDef Parity, 
                 UART2_SyncMode_TypeDef SyncMode, UART2_Mode_TypeDef Mode);
+void UART2_InitDivider(uint16_t BaudDivider, UART2_WordLength_TypeDef WordLength, 
+                       UART2_StopBits_TypeDef StopBits, UART2_Parity_TypeDef Parity, 
+                       UART2_SyncMode_TypeDef SyncMode, UART2_Mode_TypeDef Mode);
 void UART2_Cmd(FunctionalState NewState);
 void UART2_ITConfig(UART2_IT_TypeDef UART2_IT, FunctionalState NewState);
 void UART2_HalfDuplexCmd(FunctionalState NewState);
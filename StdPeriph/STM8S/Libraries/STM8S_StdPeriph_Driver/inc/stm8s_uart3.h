@@ -176,6 +176,10 @@ typedef enum { UART3_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros ------------------------------------------------------------*/
+/* UART3DIV for UART3_InitDivider(): CLOCK (fMASTER, Hz) / BAUDRATE rounded,
+   constant folded when both are constants */
+#define UART3_BAUD_DIVIDER(CLOCK, BAUDRATE) \
+  ((uint16_t)(((uint32_t)(CLOCK) + ((uint32_t)(BAUDRATE) / 2)) / (uint32_t)(BAUDRATE)))
 
 /* Private macros ------------------------------------------------------------*/
 
@@ -311,6 +315,7 @@ typedef enum { UART3_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
  *        baudrate value
  */
 #define IS_UART3_BAUDRATE_OK(NUM) ((NUM) <= (uint32_t)625000)
+#define IS_UART3_BAUDDIVIDER_OK(NUM) ((NUM) >= (uint16_t)16)
 
 /**
  * @brief Macro used by the assert_param function in order to check the address 
@@ -356,6 +361,9 @@ void UART3_DeInit(void);
 void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength, 
                 UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
                 UART3_Mode_TypeDef Mode);
+void UART3_InitDivider(uint16_t BaudDivider, UART3_WordLength_TypeDef WordLength, 
+                       UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
+                       UART3_Mode_TypeDef Mode);
 void UART3_Cmd(FunctionalState NewState);
 void UART3_ITConfig(UART3_IT_TypeDef UART3_IT, FunctionalState NewState);
 void UART3_LINBreakDetectionConfig(UART3_LINBreakDetectionLength_TypeDef UART3_LINBreakDetectionLength);
@@ -199,6 +199,10 @@ typedef enum { UART4_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
+/* UART4DIV for UART4_InitDivider(): CLOCK (fMASTER, Hz) / BAUDRATE rounded,
+   constant folded when both are constants */
+#define UART4_BAUD_DIVIDER(CLOCK, BAUDRATE) \
+  ((uint16_t)(((uint32_t)(CLOCK) + ((uint32_t)(BAUDRATE) / 2)) / (uint32_t)(BAUDRATE)))
 /* Private macros ------------------------------------------------------------*/
 
 /** @addtogroup UART4_Private_Macros
@@ -358,6 +362,7 @@ typedef enum { UART4_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
  *        baudrate value
  */
 #define IS_UART4_BAUDRATE_OK(NUM) ((NUM) <= (uint32_t)625000)
+#define IS_UART4_BAUDDIVIDER_OK(NUM) ((NUM) >= (uint16_t)16)
 
 /**
  * @brief Macro used by the assert_param function in order to check the address 
@@ -402,6 +407,9 @@ void UART4_DeInit(void);
 void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, 
                 UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, 
                 UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode);
+void UART4_InitDivider(uint16_t BaudDivider, UART4_WordLength_TypeDef WordLength, 
+                       UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, 
+                       UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode);
 void UART4_Cmd(FunctionalState NewState);
 void UART4_ITConfig(UART4_IT_TypeDef UART4_IT, FunctionalState NewState);
 void UART4_HalfDuplexCmd(FunctionalState NewState);
@@ -493,6 +493,51 @@ uint16_t ADC1_GetBufferValue(uint8_t Buffer)
   return ((uint16_t)temph);
 }
 
+/**
+  * @brief  Get the samples of the first buffers in one pass.
+  * @note   The alignment is checked once, then the buffer registers are read
+  *         in order, which is faster than one ADC1_GetBufferValue() per buffer.
+  * @param   Buffer specifies the array receiving the samples.
+  * @param   Count specifies the number of buffers to read, from 1 to 10.
+  * @retval None
+  * @par Required preconditions:
+  * ADC1 conversion finished.
+  */
+void ADC1_GetBufferValues(uint16_t* Buffer, uint8_t Count)
+{
+  __IO uint8_t* reg = (__IO uint8_t*)(uint16_t)ADC1_BaseAddress;
+  uint8_t temph = 0;
+  uint8_t templ = 0;
+  
+  /* Check the parameters */
+  assert_param(IS_ADC1_BUFFER_COUNT_OK(Count));
+  
+  if ((ADC1->CR2 & ADC1_CR2_ALIGN) != 0) /* Right alignment */
+  {
+    for (; Count != 0; Count--)
+    {
+      /* Read LSB first */
+      templ = reg[1];
+      /* Then read MSB */
+      temph = reg[0];
+      *Buffer++ = (uint16_t)(templ | (uint16_t)((uint16_t)temph << (uint8_t)8));
+      reg += 2;
+    }
+  }
+  else /* Left alignment */
+  {
+    for (; Count != 0; Count--)
+    {
+      /* Read MSB first*/
+      temph = reg[0];
+      /* Then read LSB */
+      templ = reg[1];
+      *Buffer++ = (uint16_t)((uint16_t)((uint16_t)templ << 6) | (uint16_t)((uint16_t)temph << 8));
+      reg += 2;
+    }
+  }
+}
+
 /**
   * @brief  Checks the specified analog watchdog channel status.
   * @param   Channel: specify the channel of which to check the analog watchdog
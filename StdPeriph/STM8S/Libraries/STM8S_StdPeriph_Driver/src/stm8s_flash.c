@@ -69,6 +69,22 @@
 #define FLASH_CLEAR_BYTE    ((uint8_t)0x00)
 #define FLASH_SET_BYTE      ((uint8_t)0xFF)
 #define OPERATION_TIMEOUT   ((uint16_t)0xFFFF)
+
+/* SDCC selects the code segment per translation unit: with RAM_EXECUTION this
+   file is compiled twice, the RAM_SEG_BUILD pass holding only the functions
+   to be executed from RAM */
+#if defined (_SDCC_) && defined (RAM_EXECUTION)
+ #if defined (RAM_SEG_BUILD)
+  #define FLASH_ROM_FUNCTIONS  0
+  #define FLASH_RAM_FUNCTIONS  1
+ #else
+  #define FLASH_ROM_FUNCTIONS  1
+  #define FLASH_RAM_FUNCTIONS  0
+ #endif /* RAM_SEG_BUILD */
+#else
+ #define FLASH_ROM_FUNCTIONS  1
+ #define FLASH_RAM_FUNCTIONS  1
+#endif /* _SDCC_ && RAM_EXECUTION */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -78,6 +94,8 @@
   * @{
   */
 
+#if FLASH_ROM_FUNCTIONS
+
 /**
   * @brief  Unlocks the program or data EEPROM memory
   * @param  FLASH_MemType : Memory type to unlock
@@ -157,11 +175,12 @@ void FLASH_ITConfig(FunctionalState NewState)
 /**
   * @brief  Erases one byte in the program or data EEPROM memory
   * @note   PointerAttr define is declared in the stm8s.h file to select if 
-  *         the pointer will be declared as near (2 bytes) or far (3 bytes).
+  *         the pointer will be declared as near (2 bytes) or far (3 bytes),
+  *         and FLASH_Address_TypeDef the address type accordingly.
   * @param  Address : Address of the byte to erase
   * @retval None
   */
-void FLASH_EraseByte(uint32_t Address)
+void FLASH_EraseByte(FLASH_Address_TypeDef Address)
 {
   /* Check parameter */
   assert_param(IS_FLASH_ADDRESS_OK(Address));
@@ -173,12 +192,13 @@ void FLASH_EraseByte(uint32_t Address)
 /**
   * @brief  Programs one byte in program or data EEPROM memory
   * @note   PointerAttr define is declared in the stm8s.h file to select if 
-  *         the pointer will be declared as near (2 bytes) or far (3 bytes).
+  *         the pointer will be declared as near (2 bytes) or far (3 bytes),
+  *         and FLASH_Address_TypeDef the address type accordingly.
   * @param  Address : Address where the byte will be programmed
   * @param  Data : Value to be programmed
   * @retval None
   */
-void FLASH_ProgramByte(uint32_t Address, uint8_t Data)
+void FLASH_ProgramByte(FLASH_Address_TypeDef Address, uint8_t Data)
 {
   /* Check parameters */
   assert_param(IS_FLASH_ADDRESS_OK(Address));
@@ -188,11 +208,12 @@ void FLASH_ProgramByte(uint32_t Address, uint8_t Data)
 /**
   * @brief  Reads any byte from flash memory
   * @note   PointerAttr define is declared in the stm8s.h file to select if 
-  *         the pointer will be declared as near (2 bytes) or far (3 bytes).
+  *         the pointer will be declared as near (2 bytes) or far (3 bytes),
+  *         and FLASH_Address_TypeDef the address type accordingly.
   * @param  Address : Address to read
   * @retval Value of the byte
   */
-uint8_t FLASH_ReadByte(uint32_t Address)
+uint8_t FLASH_ReadByte(FLASH_Address_TypeDef Address)
 {
   /* Check parameter */
   assert_param(IS_FLASH_ADDRESS_OK(Address));
@@ -204,12 +225,13 @@ uint8_t FLASH_ReadByte(uint32_t Address)
 /**
   * @brief  Programs one word (4 bytes) in program or data EEPROM memory
   * @note   PointerAttr define is declared in the stm8s.h file to select if 
-  *         the pointer will be declared as near (2 bytes) or far (3 bytes).
+  *         the pointer will be declared as near (2 bytes) or far (3 bytes),
+  *         and FLASH_Address_TypeDef the address type accordingly.
   * @param  Address : The address where the data will be programmed
   * @param  Data : Value to be programmed
   * @retval None
   */
-void FLASH_ProgramWord(uint32_t Address, uint32_t Data)
+void FLASH_ProgramWord(FLASH_Address_TypeDef Address, uint32_t Data)
 {
   /* Check parameters */
   assert_param(IS_FLASH_ADDRESS_OK(Address));
@@ -434,12 +456,25 @@ FlagStatus FLASH_GetFlagStatus(FLASH_Flag_TypeDef FLASH_FLAG)
   return status;
 }
 
+#endif /* FLASH_ROM_FUNCTIONS */
+
+#if FLASH_RAM_FUNCTIONS
+
 /**
 @code
  All the functions defined below must be executed from RAM exclusively, except
  for the FLASH_WaitForLastOperation function which can be executed from Flash.
 
  Steps of the execution from RAM differs from one toolchain to another:
+ - For SDCC Compiler:
+    1- Define RAM_EXECUTION for the whole target, e.g. with STM8_ADD_RAM_SEGMENT
+    and STM8_SET_RAM_SEGMENT_PROPERTIES from sdcc-stm8.cmake.
+    2- This file is then compiled a second time with RAM_SEG_BUILD defined and
+    "--codeseg RAM_SEG", the RAM_SEG segment is linked at its RAM address and
+    its image is moved to the end of the Flash in the .ihx file.
+    3- The segment is copied from Flash to RAM by __sdcc_external_startup()
+    (stm8_ram.c) before main(), or by calling RAM_SEG_Load() explicitly.
+
  - For Cosmic Compiler:
     1- Define a segment FLASH_CODE by the mean of " #pragma section (FLASH_CODE)".
     This segment is defined in the stm8s_flash.c file.
@@ -701,6 +736,8 @@ IN_RAM(void FLASH_ProgramBlock(uint16_t BlockNum, FLASH_MemType_TypeDef FLASH_Me
  #pragma section ()
 #endif /* _COSMIC_ && RAM_EXECUTION */
 
+#endif /* FLASH_RAM_FUNCTIONS */
+
 
 /**
   * @}
@@ -95,6 +95,41 @@ void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength,
   
   /* Check the parameters */
   assert_param(IS_UART1_BAUDRATE_OK(BaudRate));
+
+  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
+  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
+  /* UART1DIV: mantissa and 4 bits fraction */
+  UART1_InitDivider((uint16_t)((BaudRate_Mantissa << 4) |
+                               (((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100)) << 4) / 100)),
+                    WordLength, StopBits, Parity, SyncMode, Mode);
+}
+
+/**
+  * @brief  Initializes the UART1 with a constant baud rate divider.
+  * @note   UART1_BAUD_DIVIDER() folds the divider at compile time, so
+  *         CLK_GetClockFreq() and the 32-bit division of UART1_Init()
+  *         are not linked.
+  * @note   Configure in Push Pull or Open Drain mode the Tx pin by setting the
+  *         correct I/O Port register according the product package and line
+  *         configuration
+  * @param  BaudDivider: UART1DIV, fMASTER / baud rate.
+  * @param  WordLength : This parameter can be any of the 
+  *         @ref UART1_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART1_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART1_Parity_TypeDef enumeration.
+  * @param  SyncMode: This parameter can be any of the 
+  *         @ref UART1_SyncMode_TypeDef values.
+  * @param  Mode: This parameter can be any of the @ref UART1_Mode_TypeDef values
+  * @retval None
+  */
+void UART1_InitDivider(uint16_t BaudDivider, UART1_WordLength_TypeDef WordLength, 
+                       UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
+                       UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART1_BAUDDIVIDER_OK(BaudDivider));
   assert_param(IS_UART1_WORDLENGTH_OK(WordLength));
   assert_param(IS_UART1_STOPBITS_OK(StopBits));
   assert_param(IS_UART1_PARITY_OK(Parity));
@@ -124,15 +159,10 @@ void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength,
   /* Clear the Fraction bits of UART1DIV */
   UART1->BRR2 &= (uint8_t)(~UART1_BRR2_DIVF);  
   
-  /* Set the UART1 BaudRates in BRR1 and BRR2 registers according to UART1_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  /* Set the fraction of UART1DIV  */
-  UART1->BRR2 |= (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100)) << 4) / 100) & (uint8_t)0x0F); 
-  /* Set the MSB mantissa of UART1DIV  */
-  UART1->BRR2 |= (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0); 
-  /* Set the LSB mantissa of UART1DIV  */
-  UART1->BRR1 |= (uint8_t)BaudRate_Mantissa;           
+  /* Set the fraction and MSB mantissa of UART1DIV in one step, then its LSB mantissa */
+  UART1->BRR2 = (uint8_t)((uint8_t)((uint8_t)(BaudDivider >> 8) & (uint8_t)0xF0) |
+                          (uint8_t)((uint8_t)BaudDivider & (uint8_t)0x0F));
+  UART1->BRR1 = (uint8_t)(BaudDivider >> 4);
   
   /* Disable the Transmitter and Receiver before setting the LBCL, CPOL and CPHA bits */
   UART1->CR2 &= (uint8_t)~(UART1_CR2_TEN | UART1_CR2_REN); 
@@ -84,7 +84,6 @@ void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength,
                 UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
                 UART3_Mode_TypeDef Mode)
 {
-  uint8_t BRR2_1 = 0, BRR2_2 = 0;
   uint32_t BaudRate_Mantissa = 0, BaudRate_Mantissa100 = 0;
   
   /* Check the parameters */
@@ -92,6 +91,39 @@ void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength,
   assert_param(IS_UART3_STOPBITS_OK(StopBits));
   assert_param(IS_UART3_PARITY_OK(Parity));
   assert_param(IS_UART3_BAUDRATE_OK(BaudRate));
+
+  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
+  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
+  /* UART3DIV: mantissa and 4 bits fraction */
+  UART3_InitDivider((uint16_t)((BaudRate_Mantissa << 4) |
+                               (((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100)) << 4) / 100)),
+                    WordLength, StopBits, Parity, Mode);
+}
+
+/**
+  * @brief  Initializes the UART3 with a constant baud rate divider.
+  * @note   UART3_BAUD_DIVIDER() folds the divider at compile time, so
+  *         CLK_GetClockFreq() and the 32-bit division of UART3_Init()
+  *         are not linked.
+  * @param  BaudDivider: UART3DIV, fMASTER / baud rate.
+  * @param  WordLength : This parameter can be any of 
+  *         the @ref UART3_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART3_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART3_Parity_TypeDef enumeration.
+  * @param  Mode: This parameter can be any of the @ref UART3_Mode_TypeDef values
+  * @retval None
+  */
+void UART3_InitDivider(uint16_t BaudDivider, UART3_WordLength_TypeDef WordLength, 
+                       UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
+                       UART3_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART3_WORDLENGTH_OK(WordLength));
+  assert_param(IS_UART3_STOPBITS_OK(StopBits));
+  assert_param(IS_UART3_PARITY_OK(Parity));
+  assert_param(IS_UART3_BAUDDIVIDER_OK(BaudDivider));
   assert_param(IS_UART3_MODE_OK((uint8_t)Mode));
   
   /* Clear the word length bit */
@@ -116,18 +148,10 @@ void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength,
   /* Clear the Fraction bits of UART3DIV */
   UART3->BRR2 &= (uint8_t)(~UART3_BRR2_DIVF);  
   
-  /* Set the UART3 BaudRates in BRR1 and BRR2 registers according to UART3_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  /* The fraction and MSB mantissa should be loaded in one step in the BRR2 register */
-  /* Set the fraction of UART3DIV  */
-  BRR2_1 = (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100))
-                                << 4) / 100) & (uint8_t)0x0F); 
-  BRR2_2 = (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0);
-  
-  UART3->BRR2 = (uint8_t)(BRR2_1 | BRR2_2);
-  /* Set the LSB mantissa of UART3DIV  */
-  UART3->BRR1 = (uint8_t)BaudRate_Mantissa;           
+  /* Set the fraction and MSB mantissa of UART3DIV in one step, then its LSB mantissa */
+  UART3->BRR2 = (uint8_t)((uint8_t)((uint8_t)(BaudDivider >> 8) & (uint8_t)0xF0) |
+                          (uint8_t)((uint8_t)BaudDivider & (uint8_t)0x0F));
+  UART3->BRR1 = (uint8_t)(BaudDivider >> 4);
   
   if ((uint8_t)(Mode & UART3_MODE_TX_ENABLE))
   {
@@ -84,11 +84,40 @@ void UART4_DeInit(void)
   */
 void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode)
 {
-  uint8_t BRR2_1 = 0, BRR2_2 = 0;
   uint32_t BaudRate_Mantissa = 0, BaudRate_Mantissa100 = 0;
   
   /* Check the parameters */
   assert_param(IS_UART4_BAUDRATE_OK(BaudRate));
+
+  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
+  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
+  /* UART4DIV: mantissa and 4 bits fraction */
+  UART4_InitDivider((uint16_t)((BaudRate_Mantissa << 4) |
+                               (((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100)) << 4) / 100)),
+                    WordLength, StopBits, Parity, SyncMode, Mode);
+}
+
+/**
+  * @brief  Initializes the UART4 with a constant baud rate divider.
+  * @note   UART4_BAUD_DIVIDER() folds the divider at compile time, so
+  *         CLK_GetClockFreq() and the 32-bit division of UART4_Init()
+  *         are not linked.
+  * @param  BaudDivider: UART4DIV, fMASTER / baud rate.
+  * @param  WordLength : This parameter can be any of the 
+  *         @ref UART4_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART4_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART4_Parity_TypeDef enumeration.
+  * @param  SyncMode: This parameter can be any of the 
+  *         @ref UART4_SyncMode_TypeDef values.
+  * @param  Mode: This parameter can be any of the @ref UART4_Mode_TypeDef values
+  * @retval None
+  */
+void UART4_InitDivider(uint16_t BaudDivider, UART4_WordLength_TypeDef WordLength, UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART4_BAUDDIVIDER_OK(BaudDivider));
   assert_param(IS_UART4_WORDLENGTH_OK(WordLength));
   assert_param(IS_UART4_STOPBITS_OK(StopBits));
   assert_param(IS_UART4_PARITY_OK(Parity));
@@ -117,19 +146,10 @@ void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, UART4_St
   /* Clear the Fraction bits of UART4DIV */
   UART4->BRR2 &= (uint8_t)(~UART4_BRR2_DIVF);
   
-  /* Set the UART4 BaudRates in BRR1 and BRR2 registers according to UART4_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  
-  /* The fraction and MSB mantissa should be loaded in one step in the BRR2 register*/
-  /* Set the fraction of UARTDIV  */
-  BRR2_1 = (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100))
-                                << 4) / 100) & (uint8_t)0x0F); 
-  BRR2_2 = (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0);
-  
-  UART4->BRR2 = (uint8_t)(BRR2_1 | BRR2_2);
-  /* Set the LSB mantissa of UARTDIV  */
-  UART4->BRR1 = (uint8_t)BaudRate_Mantissa;           
+  /* Set the fraction and MSB mantissa of UART4DIV in one step, then its LSB mantissa */
+  UART4->BRR2 = (uint8_t)((uint8_t)((uint8_t)(BaudDivider >> 8) & (uint8_t)0xF0) |
+                          (uint8_t)((uint8_t)BaudDivider & (uint8_t)0x0F));
+  UART4->BRR1 = (uint8_t)(BaudDivider >> 4);
   
   /* Disable the Transmitter and Receiver before setting the LBCL, CPOL and CPHA bits */
   UART4->CR2 &= (uint8_t)~(UART4_CR2_TEN | UART4_CR2_REN);
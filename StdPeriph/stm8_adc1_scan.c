@@ -0,0 +1,115 @@
+#include "stm8_adc1_scan.h"
+
+#if ADC1_SCAN_CHANNELS < 1 || ADC1_SCAN_CHANNELS > 10
+#error "ADC1_SCAN_CHANNELS must be 1 to 10"
+#endif
+#if (ADC1_SCAN_FRAMES & (ADC1_SCAN_FRAMES - 1)) || ADC1_SCAN_FRAMES > 128
+#error "ADC1_SCAN_FRAMES must be 0 or a power of 2 up to 128"
+#endif
+
+static uint8_t Channels;
+static ADC1_Scan_Callback_TypeDef ScanCallback;
+static volatile uint16_t Overruns;
+
+#if ADC1_SCAN_FRAMES != 0
+/* Free running indices, Head written by the interrupt only, Tail by
+   ADC1_Scan_Read() only */
+static uint16_t Frames[ADC1_SCAN_FRAMES][ADC1_SCAN_CHANNELS];
+static volatile uint8_t Head;
+static volatile uint8_t Tail;
+#else
+static uint16_t Frame[ADC1_SCAN_CHANNELS];
+#endif
+
+void ADC1_Scan_Start(ADC1_Scan_Callback_TypeDef Callback)
+{
+  Channels = (uint8_t)((ADC1->CSR & ADC1_CSR_CH) + 1);
+  if (Channels > ADC1_SCAN_CHANNELS)
+  {
+    Channels = ADC1_SCAN_CHANNELS;
+  }
+  ScanCallback = Callback;
+  Overruns = 0;
+#if ADC1_SCAN_FRAMES != 0
+  Head = Tail = 0;
+#endif
+
+  ADC1->CR3 &= (uint8_t)~ADC1_CR3_OVR;
+  ADC1->CR1 |= ADC1_CR1_CONT;
+  ADC1_ScanModeCmd(ENABLE);
+  ADC1_DataBufferCmd(ENABLE);
+  ADC1_ITConfig(ADC1_IT_EOCIE, ENABLE);
+  //ADC1_Init() powered ADC1 on, setting ADON again starts the conversions
+  ADC1_StartConversion();
+}
+
+void ADC1_Scan_Stop(void)
+{
+  ADC1->CR1 &= (uint8_t)~ADC1_CR1_CONT;
+  ADC1_ITConfig(ADC1_IT_EOCIE, DISABLE);
+}
+
+/* Read again until unchanged by the interrupt */
+uint16_t ADC1_Scan_GetOverruns(void)
+{
+  uint16_t count;
+
+  do
+  {
+    count = Overruns;
+  } while (count != Overruns);
+  return count;
+}
+
+#if ADC1_SCAN_FRAMES != 0
+uint8_t ADC1_Scan_Read(uint16_t* Frame)
+{
+  uint8_t tail = Tail;
+  uint16_t* frame;
+  uint8_t i;
+
+  if (tail == Head)
+  {
+    return 0;
+  }
+  frame = Frames[tail & (ADC1_SCAN_FRAMES - 1)];
+  for (i = 0; i < Channels; i++)
+  {
+    Frame[i] = frame[i];
+  }
+  Tail = (uint8_t)(tail + 1);
+  return 1;
+}
+#endif
+
+ADC1_SCAN_IRQHandler()
+{
+  uint16_t* frame;
+
+  if (ADC1->CR3 & ADC1_CR3_OVR)
+  {
+    ADC1->CR3 &= (uint8_t)~ADC1_CR3_OVR;
+    Overruns++;
+  }
+#if ADC1_SCAN_FRAMES != 0
+  if ((uint8_t)(Head - Tail) == ADC1_SCAN_FRAMES)
+  {
+    //Queue full, the newest frame is lost
+    ADC1->CSR &= (uint8_t)~ADC1_CSR_EOC;
+    Overruns++;
+    return;
+  }
+  frame = Frames[Head & (ADC1_SCAN_FRAMES - 1)];
+#else
+  frame = Frame;
+#endif
+  ADC1_GetBufferValues(frame, Channels);
+  ADC1->CSR &= (uint8_t)~ADC1_CSR_EOC;
+#if ADC1_SCAN_FRAMES != 0
+  Head++;
+#endif
+  if (ScanCallback)
+  {
+    ScanCallback(frame);
+  }
+}
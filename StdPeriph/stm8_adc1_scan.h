@@ -0,0 +1,58 @@
+#ifndef STM8_ADC1_SCAN_H_
+#define STM8_ADC1_SCAN_H_
+
+/*
+ * Continuous buffered scan of ADC1 on STM8S (STM8S103/003, STM8S105/005,
+ * STM8S903)
+ *
+ * Configure ADC1 with the StdPeriph driver: ADC1_Init() in continuous mode
+ * with the highest channel of the scan, then call ADC1_Scan_Start(). ADC1
+ * converts channels 0 to that channel over and over into its data buffer,
+ * the end of conversion interrupt copies each scan (a frame) with
+ * ADC1_GetBufferValues() and calls the callback (in interrupt context) with
+ * it. With ADC1_SCAN_FRAMES defined the frames are also queued for
+ * ADC1_Scan_Read() in the main program.
+ * Include this header in the file with main() so SDCC generates the vector.
+ */
+
+#if !defined(STM8_FAMILY_S)
+#error "STM8_FAMILY_S is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+#include <stm8s.h>
+#include <stm8s_adc1.h>
+#include "stm8_it.h"
+
+#if defined(STM8S903)
+//stm8_it.h names the STM8S903 ADC1 vector after ADC2
+#define ADC1_SCAN_IRQHandler ADC2_IRQHandler
+#elif defined(STM8S103) || defined(STM8S003) || defined(STM8S105) || defined(STM8S005)
+#define ADC1_SCAN_IRQHandler ADC1_IRQHandler
+#else
+#error "ADC1 with data buffer is not available on this chip"
+#endif
+
+//Highest number of channels per frame, up to 10
+#ifndef ADC1_SCAN_CHANNELS
+#define ADC1_SCAN_CHANNELS 10
+#endif
+
+//Frames queued for ADC1_Scan_Read(), a power of 2 up to 128, 0 for none
+#ifndef ADC1_SCAN_FRAMES
+#define ADC1_SCAN_FRAMES 0
+#endif
+
+//Called with one sample per channel of the scan, may be 0
+typedef void (*ADC1_Scan_Callback_TypeDef)(uint16_t* Frame);
+
+void ADC1_Scan_Start(ADC1_Scan_Callback_TypeDef Callback);
+void ADC1_Scan_Stop(void);
+//Scans overwritten before they were read (ADC1 overrun or full queue)
+uint16_t ADC1_Scan_GetOverruns(void);
+#if ADC1_SCAN_FRAMES != 0
+//Copies the oldest queued frame to Frame, returns 0 when there is none
+uint8_t ADC1_Scan_Read(uint16_t* Frame);
+#endif
+
+ADC1_SCAN_IRQHandler();
+
+#endif //STM8_ADC1_SCAN_H_
@@ -0,0 +1,60 @@
+#include "stm8_adc_stream.h"
+#include <stm8l15x_clk.h>
+#include <stm8l15x_dma.h>
+
+#define ADC_STREAM_DMA_CHANNEL DMA1_Channel0
+//16-bit transfers read DRH then DRL
+#define ADC_STREAM_DR_ADDRESS  ((uint16_t)&ADC1->DRH)
+
+static uint16_t* StreamBuffer;
+static uint8_t StreamCount;
+static ADC_Stream_Callback_TypeDef StreamCallback;
+
+void ADC_Stream_Init(uint16_t* Buffer, uint8_t Count, ADC_Stream_Callback_TypeDef Callback)
+{
+  StreamBuffer = Buffer;
+  StreamCount = Count;
+  StreamCallback = Callback;
+
+  CLK_PeripheralClockConfig(CLK_Peripheral_DMA1, ENABLE);
+  DMA_Init(ADC_STREAM_DMA_CHANNEL, (uint32_t)(uint16_t)Buffer, ADC_STREAM_DR_ADDRESS, (uint8_t)(Count * 2),
+           DMA_DIR_PeripheralToMemory, DMA_Mode_Circular, DMA_MemoryIncMode_Inc,
+           DMA_Priority_VeryHigh, DMA_MemoryDataSize_HalfWord);
+  DMA_ITConfig(ADC_STREAM_DMA_CHANNEL, (DMA_ITx_TypeDef)(DMA_ITx_HT | DMA_ITx_TC), ENABLE);
+  DMA_GlobalCmd(ENABLE);
+}
+
+/* The transfer restarts at the beginning of the buffer */
+void ADC_Stream_Start(ADC_ExtEventSelection_TypeDef Trigger, ADC_ExtTRGSensitivity_TypeDef Edge)
+{
+  ADC_STREAM_DMA_CHANNEL->CNBTR = (uint8_t)(StreamCount * 2);
+  ADC_STREAM_DMA_CHANNEL->CSPR &= (uint8_t)~(DMA_CSPR_HTIF | DMA_CSPR_TCIF);
+  ADC_STREAM_DMA_CHANNEL->CCR |= DMA_CCR_CE;
+  ADC_DMACmd(ADC1, ENABLE);
+  ADC_ExternalTrigConfig(ADC1, Trigger, Edge);
+}
+
+void ADC_Stream_Stop(void)
+{
+  ADC1->CR2 &= (uint8_t)~(ADC_CR2_EXTSEL | ADC_CR2_TRIGEDGE);
+  ADC_DMACmd(ADC1, DISABLE);
+  ADC_STREAM_DMA_CHANNEL->CCR &= (uint8_t)~DMA_CCR_CE;
+}
+
+/* Both flags are set when the interrupt was held off for half a buffer, the
+   halves are then passed in order */
+void ADC_Stream_DMA_IRQHandler(void)
+{
+  uint8_t status = ADC_STREAM_DMA_CHANNEL->CSPR;
+
+  if (status & DMA_CSPR_HTIF)
+  {
+    ADC_STREAM_DMA_CHANNEL->CSPR &= (uint8_t)~DMA_CSPR_HTIF;
+    StreamCallback(StreamBuffer);
+  }
+  if (status & DMA_CSPR_TCIF)
+  {
+    ADC_STREAM_DMA_CHANNEL->CSPR &= (uint8_t)~DMA_CSPR_TCIF;
+    StreamCallback(StreamBuffer + StreamCount);
+  }
+}
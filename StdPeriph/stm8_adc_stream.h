@@ -0,0 +1,35 @@
+#ifndef STM8_ADC_STREAM_H_
+#define STM8_ADC_STREAM_H_
+
+/*
+ * Timer triggered ADC1 acquisition streamed by DMA on STM8L15x
+ *
+ * Configure ADC1 with the StdPeriph driver (ADC_Init, ADC_ChannelCmd,
+ * ADC_SamplingTimeConfig) and a timer whose TRGO is the sample clock
+ * (TIMx_SelectOutputTrigger). Each trigger converts all enabled channels, DMA1
+ * channel 0 stores the conversions into a circular buffer of 2 * Count samples
+ * and the callback is called (in interrupt context) with the half just filled,
+ * while the DMA fills the other half. Count should be a multiple of the
+ * number of enabled channels.
+ *
+ * DMA1 channels 0 and 1 share their vector, call ADC_Stream_DMA_IRQHandler()
+ * from DMA1_CHANNEL0_1_IRQHandler().
+ */
+
+#if !defined(STM8_FAMILY_L15X)
+#error "The ADC stream is only available on STM8L15x"
+#endif
+#include <stm8l15x.h>
+#include <stm8l15x_adc.h>
+
+//Called with Count samples on half and full transfer
+typedef void (*ADC_Stream_Callback_TypeDef)(uint16_t* Samples);
+
+//Buffer holds 2 * Count samples, Count up to 127
+void ADC_Stream_Init(uint16_t* Buffer, uint8_t Count, ADC_Stream_Callback_TypeDef Callback);
+void ADC_Stream_Start(ADC_ExtEventSelection_TypeDef Trigger, ADC_ExtTRGSensitivity_TypeDef Edge);
+void ADC_Stream_Stop(void);
+
+void ADC_Stream_DMA_IRQHandler(void);
+
+#endif //STM8_ADC_STREAM_H_
@@ -0,0 +1,223 @@
+#include "stm8_aes_dma.h"
+#include <stm8l15x_clk.h>
+#include <stm8l15x_dma.h>
+
+#define AES_DMA_IN  DMA1_Channel0
+#define AES_DMA_OUT DMA1_Channel3
+//Whole blocks in one DMA run (8-bit counters)
+#define AES_DMA_RUN_BLOCKS 15
+
+//Key loaded in the AES: an AES_Operation_TypeDef, or none
+#define AES_DMA_KEY_NONE ((uint8_t)0xFF)
+
+static uint8_t Key[AES_DMA_BLOCK_SIZE];
+static uint8_t DecryptKey[AES_DMA_BLOCK_SIZE];
+static uint8_t Derived;
+static uint8_t Loaded;
+
+void AES_DMA_Init(void)
+{
+  CLK_PeripheralClockConfig(CLK_Peripheral_AES, ENABLE);
+  CLK_PeripheralClockConfig(CLK_Peripheral_DMA1, ENABLE);
+  AES_DeInit();
+  DMA_Init(AES_DMA_IN, 0, (uint16_t)&AES->DINR, AES_DMA_BLOCK_SIZE, DMA_DIR_MemoryToPeripheral,
+           DMA_Mode_Normal, DMA_MemoryIncMode_Inc, DMA_Priority_High, DMA_MemoryDataSize_Byte);
+  DMA_Init(AES_DMA_OUT, 0, (uint16_t)&AES->DOUTR, AES_DMA_BLOCK_SIZE, DMA_DIR_PeripheralToMemory,
+           DMA_Mode_Normal, DMA_MemoryIncMode_Inc, DMA_Priority_VeryHigh, DMA_MemoryDataSize_Byte);
+  DMA_GlobalCmd(ENABLE);
+  Derived = 0;
+  Loaded = AES_DMA_KEY_NONE;
+}
+
+void AES_DMA_SetKey(const uint8_t* NewKey)
+{
+  uint8_t i;
+
+  for (i = 0; i < AES_DMA_BLOCK_SIZE; i++)
+  {
+    Key[i] = NewKey[i];
+  }
+  Derived = 0;
+  Loaded = AES_DMA_KEY_NONE;
+}
+
+/* The mode can only be changed with the AES disabled, the first 16 bytes
+   written after enabling it are the key */
+static void AES_DMA_Enable(AES_Operation_TypeDef Operation, const uint8_t* Source)
+{
+  uint8_t i;
+
+  AES->CR = 0;
+  AES->CR = (uint8_t)(AES_CR_ERRC | AES_CR_CCFC | Operation);
+  AES->CR = (uint8_t)(AES_CR_EN | Operation);
+  for (i = 0; i < AES_DMA_BLOCK_SIZE; i++)
+  {
+    AES->DINR = Source[i];
+  }
+}
+
+static void AES_DMA_LoadKey(AES_Operation_TypeDef Operation)
+{
+  uint8_t i;
+
+  if (Loaded == (uint8_t)Operation)
+  {
+    return;
+  }
+  if (Operation == AES_Operation_Decryp && !Derived)
+  {
+    //Last round key of the encryption schedule, first of the decryption
+    AES_DMA_Enable(AES_Operation_KeyDeriv, Key);
+    while (!(AES->SR & AES_SR_CCF))
+    {
+    }
+    for (i = 0; i < AES_DMA_BLOCK_SIZE; i++)
+    {
+      DecryptKey[i] = AES->DOUTR;
+    }
+    Derived = 1;
+  }
+  AES_DMA_Enable(Operation, Operation == AES_Operation_Decryp ? DecryptKey : Key);
+  Loaded = (uint8_t)Operation;
+}
+
+/* The input channel writes a block on each AES input request, the output
+   channel reads it back when it is processed: the run ends with the output */
+static void AES_DMA_Run(const uint8_t* In, uint8_t* Out, uint8_t Blocks)
+{
+  uint8_t count = (uint8_t)(Blocks * AES_DMA_BLOCK_SIZE);
+
+  AES_DMA_IN->CM0ARH = (uint8_t)((uint16_t)In >> 8);
+  AES_DMA_IN->CM0ARL = (uint8_t)(uint16_t)In;
+  AES_DMA_IN->CNBTR = count;
+  AES_DMA_OUT->CM0ARH = (uint8_t)((uint16_t)Out >> 8);
+  AES_DMA_OUT->CM0ARL = (uint8_t)(uint16_t)Out;
+  AES_DMA_OUT->CNBTR = count;
+  AES_DMA_OUT->CCR |= DMA_CCR_CE;
+  AES_DMA_IN->CCR |= DMA_CCR_CE;
+  AES->CR |= AES_CR_DMAEN;
+  while (!(AES_DMA_OUT->CSPR & DMA_CSPR_TCIF))
+  {
+  }
+  AES->CR &= (uint8_t)~AES_CR_DMAEN;
+  AES_DMA_IN->CCR &= (uint8_t)~DMA_CCR_CE;
+  AES_DMA_OUT->CCR &= (uint8_t)~DMA_CCR_CE;
+  AES_DMA_IN->CSPR &= (uint8_t)~DMA_CSPR_TCIF;
+  AES_DMA_OUT->CSPR &= (uint8_t)~DMA_CSPR_TCIF;
+}
+
+static void AES_DMA_Blocks(const uint8_t* In, uint8_t* Out, uint16_t Blocks)
+{
+  uint8_t run;
+
+  while (Blocks != 0)
+  {
+    run = Blocks > AES_DMA_RUN_BLOCKS ? AES_DMA_RUN_BLOCKS : (uint8_t)Blocks;
+    AES_DMA_Run(In, Out, run);
+    In += run * AES_DMA_BLOCK_SIZE;
+    Out += run * AES_DMA_BLOCK_SIZE;
+    Blocks -= run;
+  }
+}
+
+static void AES_DMA_Xor(uint8_t* Data, const uint8_t* Mask, uint8_t Length)
+{
+  for (; Length != 0; Length--)
+  {
+    *Data++ ^= *Mask++;
+  }
+}
+
+static void AES_DMA_Copy(uint8_t* Data, const uint8_t* Source)
+{
+  uint8_t i;
+
+  for (i = 0; i < AES_DMA_BLOCK_SIZE; i++)
+  {
+    Data[i] = Source[i];
+  }
+}
+
+void AES_DMA_ECB_Encrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks)
+{
+  AES_DMA_LoadKey(AES_Operation_Encryp);
+  AES_DMA_Blocks(In, Out, Blocks);
+}
+
+void AES_DMA_ECB_Decrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks)
+{
+  AES_DMA_LoadKey(AES_Operation_Decryp);
+  AES_DMA_Blocks(In, Out, Blocks);
+}
+
+/* Each block depends on the previous ciphertext: one block per DMA run */
+void AES_DMA_CBC_Encrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks, uint8_t* Iv)
+{
+  AES_DMA_LoadKey(AES_Operation_Encryp);
+  for (; Blocks != 0; Blocks--)
+  {
+    AES_DMA_Xor(Iv, In, AES_DMA_BLOCK_SIZE);
+    AES_DMA_Run(Iv, Out, 1);
+    AES_DMA_Copy(Iv, Out);
+    In += AES_DMA_BLOCK_SIZE;
+    Out += AES_DMA_BLOCK_SIZE;
+  }
+}
+
+/* With separate buffers all the blocks are decrypted in DMA runs, then
+   chained from the last one while the ciphertext is still there. In place,
+   the ciphertext of each block is saved first. */
+void AES_DMA_CBC_Decrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks, uint8_t* Iv)
+{
+  uint8_t next[AES_DMA_BLOCK_SIZE];
+  uint16_t offset;
+
+  if (Blocks == 0)
+  {
+    return;
+  }
+  AES_DMA_LoadKey(AES_Operation_Decryp);
+  if (In != Out)
+  {
+    AES_DMA_Blocks(In, Out, Blocks);
+    for (offset = (Blocks - 1) * AES_DMA_BLOCK_SIZE; offset != 0; offset -= AES_DMA_BLOCK_SIZE)
+    {
+      AES_DMA_Xor(Out + offset, In + offset - AES_DMA_BLOCK_SIZE, AES_DMA_BLOCK_SIZE);
+    }
+    AES_DMA_Xor(Out, Iv, AES_DMA_BLOCK_SIZE);
+    AES_DMA_Copy(Iv, In + (Blocks - 1) * AES_DMA_BLOCK_SIZE);
+    return;
+  }
+  for (; Blocks != 0; Blocks--)
+  {
+    AES_DMA_Copy(next, Out);
+    AES_DMA_Run(next, Out, 1);
+    AES_DMA_Xor(Out, Iv, AES_DMA_BLOCK_SIZE);
+    AES_DMA_Copy(Iv, next);
+    Out += AES_DMA_BLOCK_SIZE;
+  }
+}
+
+void AES_DMA_CTR_Crypt(const uint8_t* In, uint8_t* Out, uint16_t Length, uint8_t* Counter)
+{
+  uint8_t stream[AES_DMA_BLOCK_SIZE];
+  uint8_t length;
+  uint8_t i;
+
+  AES_DMA_LoadKey(AES_Operation_Encryp);
+  while (Length != 0)
+  {
+    length = Length > AES_DMA_BLOCK_SIZE ? AES_DMA_BLOCK_SIZE : (uint8_t)Length;
+    AES_DMA_Run(Counter, stream, 1);
+    for (i = AES_DMA_BLOCK_SIZE - 1; ++Counter[i] == 0 && i != 0; i--)
+    {
+    }
+    for (i = 0; i < length; i++)
+    {
+      Out[i] = (uint8_t)(In[i] ^ stream[i]);
+    }
+    In += length;
+    Out += length;
+    Length -= length;
+  }
+}
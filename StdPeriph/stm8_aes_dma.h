@@ -0,0 +1,43 @@
+#ifndef STM8_AES_DMA_H_
+#define STM8_AES_DMA_H_
+
+/*
+ * AES-128 block and stream encryption on the STM8L15x AES coprocessor
+ *
+ * The blocks are fed to the AES by DMA1 channel 0 (memory to AES_DINR) and
+ * read back by DMA1 channel 3 (AES_DOUTR to memory), up to 15 blocks per DMA
+ * run, instead of 32 driver calls per block. CBC and CTR are chained in
+ * software on top of the hardware ECB.
+ *
+ * The key stays loaded while the AES is enabled: it is written again only
+ * when the direction changes or after AES_DMA_SetKey(). The decryption key
+ * schedule is derived once per key (AES key derivation mode) and reused.
+ *
+ * The AES is only available on the STM8L16x (component aes). The functions
+ * block until the data is processed and use DMA1 channels 0 and 3, which can't
+ * serve other peripherals meanwhile.
+ */
+
+#if !defined(STM8_FAMILY_L15X)
+#error "The AES is only available on STM8L15x"
+#endif
+#include <stm8l15x.h>
+#include <stm8l15x_aes.h>
+
+#define AES_DMA_BLOCK_SIZE 16
+
+void AES_DMA_Init(void);
+//Key of AES_DMA_BLOCK_SIZE bytes, copied
+void AES_DMA_SetKey(const uint8_t* Key);
+
+//In and Out may be the same buffer
+void AES_DMA_ECB_Encrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks);
+void AES_DMA_ECB_Decrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks);
+//Iv is updated for the next call
+void AES_DMA_CBC_Encrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks, uint8_t* Iv);
+void AES_DMA_CBC_Decrypt(const uint8_t* In, uint8_t* Out, uint16_t Blocks, uint8_t* Iv);
+/* Encrypts and decrypts Length bytes, the last block may be partial. Counter
+   is a big-endian block counter, incremented for each block */
+void AES_DMA_CTR_Crypt(const uint8_t* In, uint8_t* Out, uint16_t Length, uint8_t* Counter);
+
+#endif //STM8_AES_DMA_H_
@@ -0,0 +1,97 @@
+#include "stm8_assert.h"
+
+#if (ASSERT_LOG_RECORDS & (ASSERT_LOG_RECORDS - 1)) || ASSERT_LOG_RECORDS < 1 || ASSERT_LOG_RECORDS > 128
+#error "ASSERT_LOG_RECORDS must be a power of 2 up to 128"
+#endif
+
+#if defined(ASSERT_LOG_EEPROM)
+#define ASSERT_LOG_SAVED ((const volatile uint8_t*)(uint16_t)(ASSERT_LOG_EEPROM))
+#if defined(STM8_FAMILY_S)
+#define ASSERT_LOG_MEMTYPE FLASH_MEMTYPE_DATA
+#define ASSERT_LOG_WAIT()  FLASH_WaitForLastOperation(FLASH_MEMTYPE_DATA)
+#elif defined(STM8_FAMILY_L15X)
+#define ASSERT_LOG_MEMTYPE FLASH_MemType_Data
+#define ASSERT_LOG_WAIT()  FLASH_WaitForLastOperation(FLASH_MemType_Data)
+#else
+#define ASSERT_LOG_MEMTYPE FLASH_MemType_Data
+#define ASSERT_LOG_WAIT()  FLASH_WaitForLastOperation()
+#endif
+#endif
+
+static Assert_Record_TypeDef Records[ASSERT_LOG_RECORDS];
+static uint8_t Head;
+static uint8_t Count;
+
+void assert_compact_failed(uint8_t module, uint16_t line)
+{
+  Assert_Record_TypeDef* record;
+
+  //Called from interrupt handlers as well
+  __critical
+  {
+    record = &Records[Head & (ASSERT_LOG_RECORDS - 1)];
+    record->Module = module;
+    record->Line = line;
+    Head++;
+    if (Count != 0xFF)
+    {
+      Count++;
+    }
+  }
+
+#if defined(ASSERT_LOG_EEPROM)
+  //Only the first fault: asserts of the flash component end up here again
+  if (Count == 1 && ASSERT_LOG_SAVED[1] == 0 && ASSERT_LOG_SAVED[2] == 0)
+  {
+    FLASH_Unlock(ASSERT_LOG_MEMTYPE);
+    FLASH_ProgramByte(ASSERT_LOG_EEPROM, module);
+    ASSERT_LOG_WAIT();
+    FLASH_ProgramByte(ASSERT_LOG_EEPROM + 1, (uint8_t)(line >> 8));
+    ASSERT_LOG_WAIT();
+    FLASH_ProgramByte(ASSERT_LOG_EEPROM + 2, (uint8_t)line);
+    ASSERT_LOG_WAIT();
+    FLASH_Lock(ASSERT_LOG_MEMTYPE);
+  }
+#endif
+}
+
+uint8_t Assert_GetCount(void)
+{
+  return Count;
+}
+
+uint8_t Assert_Read(uint8_t Index, Assert_Record_TypeDef* Record)
+{
+  uint8_t found = 0;
+
+  __critical
+  {
+    if (Index < Count && Index < ASSERT_LOG_RECORDS)
+    {
+      *Record = Records[(uint8_t)(Head - 1 - Index) & (ASSERT_LOG_RECORDS - 1)];
+      found = 1;
+    }
+  }
+  return found;
+}
+
+#if defined(ASSERT_LOG_EEPROM)
+uint8_t Assert_ReadEeprom(Assert_Record_TypeDef* Record)
+{
+  Record->Module = ASSERT_LOG_SAVED[0];
+  Record->Line = (uint16_t)(((uint16_t)ASSERT_LOG_SAVED[1] << 8) | ASSERT_LOG_SAVED[2]);
+  return (uint8_t)(Record->Line != 0);
+}
+
+void Assert_ClearEeprom(void)
+{
+  FLASH_Unlock(ASSERT_LOG_MEMTYPE);
+  FLASH_EraseByte(ASSERT_LOG_EEPROM);
+  ASSERT_LOG_WAIT();
+  FLASH_EraseByte(ASSERT_LOG_EEPROM + 1);
+  ASSERT_LOG_WAIT();
+  FLASH_EraseByte(ASSERT_LOG_EEPROM + 2);
+  ASSERT_LOG_WAIT();
+  FLASH_Lock(ASSERT_LOG_MEMTYPE);
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef STM8_ASSERT_H_
+#define STM8_ASSERT_H_
+
+/*
+ * Compact assert_param fault log
+ *
+ * With USE_COMPACT_ASSERT a failed assert_param() calls
+ * assert_compact_failed() with the id of the StdPeriph component (see
+ * STM8_StdPeriph_COMPACT_ASSERT in FindSTM8_StdPeriph.cmake, 0 for the
+ * application) and the line: a few bytes of code per check and no file name
+ * strings. The faults are recorded here and execution continues.
+ *
+ * The last ASSERT_LOG_RECORDS faults are kept in RAM until the next reset.
+ * With ASSERT_LOG_EEPROM defined to a data EEPROM address, the first fault
+ * is also programmed there (3 bytes, with the flash component) and survives
+ * resets. It is only overwritten after Assert_ClearEeprom(), so a failing
+ * check in a loop doesn't wear the EEPROM.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#if defined(ASSERT_LOG_EEPROM)
+#include <stm8s_flash.h>
+#endif
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#if defined(ASSERT_LOG_EEPROM)
+#include <stm8l15x_flash.h>
+#endif
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#if defined(ASSERT_LOG_EEPROM)
+#include <stm8l10x_flash.h>
+#endif
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+
+//Faults kept in RAM, a power of 2 up to 128
+#ifndef ASSERT_LOG_RECORDS
+#define ASSERT_LOG_RECORDS 4
+#endif
+
+typedef struct
+{
+  uint8_t Module; //Component id, 0 for the application
+  uint16_t Line;  //Line of the assert_param(), 0 for none
+} Assert_Record_TypeDef;
+
+//Faults since reset, stops at 255
+uint8_t Assert_GetCount(void);
+//Copies the fault Index (0 is the newest), returns 0 when it is not kept
+uint8_t Assert_Read(uint8_t Index, Assert_Record_TypeDef* Record);
+#if defined(ASSERT_LOG_EEPROM)
+//Copies the fault saved in the data EEPROM, returns 0 when there is none
+uint8_t Assert_ReadEeprom(Assert_Record_TypeDef* Record);
+void Assert_ClearEeprom(void);
+#endif
+
+#endif //STM8_ASSERT_H_
@@ -0,0 +1,150 @@
+#include "stm8_capture.h"
+
+#if CAPTURE_BUFFER_SIZE < 2 || CAPTURE_BUFFER_SIZE > 128 || (CAPTURE_BUFFER_SIZE & (CAPTURE_BUFFER_SIZE - 1))
+#error "CAPTURE_BUFFER_SIZE must be a power of 2 up to 128"
+#endif
+
+#define CAPTURE_CHANNELS (CAPTURE_CHANNEL_1 | CAPTURE_CHANNEL_2 | CAPTURE_CHANNEL_3 | CAPTURE_CHANNEL_4)
+
+static Capture_Event_TypeDef Events[CAPTURE_BUFFER_SIZE];
+/* Written by the capture interrupt and Capture_Read() respectively */
+static volatile uint8_t Head;
+static volatile uint8_t Tail;
+static volatile uint16_t Overflows;
+static volatile uint16_t Lost;
+
+void Capture_Init(uint8_t Channels)
+{
+  Head = Tail = 0;
+  Overflows = 0;
+  Lost = 0;
+
+  TIM1->CR1 &= (uint8_t)~TIM1_CR1_CEN;
+  TIM1->ARRH = 0xFF;
+  TIM1->ARRL = 0xFF;
+  TIM1->CNTRH = 0;
+  TIM1->CNTRL = 0;
+  TIM1->SR1 = 0;
+  TIM1->SR2 = 0;
+  TIM1->IER = (uint8_t)((TIM1->IER & (uint8_t)~CAPTURE_CHANNELS) | (Channels & CAPTURE_CHANNELS) | TIM1_IER_UIE);
+  TIM1->CR1 |= TIM1_CR1_CEN;
+}
+
+uint8_t Capture_Read(Capture_Event_TypeDef* Event)
+{
+  uint8_t tail = Tail;
+
+  if (tail == Head)
+  {
+    return 0;
+  }
+  *Event = Events[tail & (CAPTURE_BUFFER_SIZE - 1)];
+  Tail = (uint8_t)(tail + 1);
+  return 1;
+}
+
+/* An update flag still set belongs to the current period when the counter
+   (or the capture) is in its lower half: the overflow happened before it */
+uint32_t Capture_Now(void)
+{
+  uint16_t high;
+  uint16_t low;
+
+  __critical
+  {
+    low = (uint16_t)TIM1->CNTRH << 8;
+    low |= TIM1->CNTRL;
+    high = Overflows;
+    if ((TIM1->SR1 & TIM1_SR1_UIF) && !(low & 0x8000))
+    {
+      high++;
+    }
+  }
+  return ((uint32_t)high << 16) | low;
+}
+
+uint16_t Capture_GetLost(void)
+{
+  uint16_t lost;
+
+  __critical
+  {
+    lost = Lost;
+  }
+  return lost;
+}
+
+CAPTURE_UPDATE_IRQHandler()
+{
+  TIM1->SR1 = (uint8_t)~TIM1_SR1_UIF;
+  Overflows++;
+}
+
+/* The captured value is read high byte first, reading the low byte clears the
+   capture flag. The channels are taken in order when several are set. */
+CAPTURE_CAPTURE_IRQHandler()
+{
+  volatile uint8_t* ccr = &TIM1->CCR1H;
+  uint8_t pending = (uint8_t)(TIM1->SR1 & TIM1->IER & CAPTURE_CHANNELS);
+  uint8_t overcapture = (uint8_t)(TIM1->SR2 & pending);
+  uint8_t mask;
+  uint8_t channel;
+  uint16_t low;
+  uint16_t high;
+  uint16_t now;
+  uint8_t head;
+
+  if (overcapture)
+  {
+    TIM1->SR2 = (uint8_t)~overcapture;
+    for (mask = CAPTURE_CHANNEL_1; mask <= CAPTURE_CHANNEL_4; mask <<= 1)
+    {
+      if (overcapture & mask)
+      {
+        Lost++;
+      }
+    }
+  }
+
+  for (channel = 1, mask = CAPTURE_CHANNEL_1; pending; channel++, mask <<= 1, ccr += 2)
+  {
+    if (!(pending & mask))
+    {
+      continue;
+    }
+    pending &= (uint8_t)~mask;
+    low = (uint16_t)ccr[0] << 8;
+    low |= ccr[1];
+    /* The update interrupt may have run before this one (lower vector number,
+       or higher priority): a capture in the upper half with the counter back
+       in the lower half and no update pending was taken before the overflow
+       already counted */
+    __critical
+    {
+      high = Overflows;
+      now = (uint16_t)TIM1->CNTRH << 8;
+      now |= TIM1->CNTRL;
+      if (TIM1->SR1 & TIM1_SR1_UIF)
+      {
+        if (!(low & 0x8000))
+        {
+          high++;
+        }
+      }
+      else if ((low & 0x8000) && !(now & 0x8000))
+      {
+        high--;
+      }
+    }
+
+    head = Head;
+    if ((uint8_t)(head - Tail) == CAPTURE_BUFFER_SIZE)
+    {
+      Lost++;
+      continue;
+    }
+    Events[head & (CAPTURE_BUFFER_SIZE - 1)].Time = ((uint32_t)high << 16) | low;
+    Events[head & (CAPTURE_BUFFER_SIZE - 1)].Channel = channel;
+    Head = (uint8_t)(head + 1);
+  }
+}
@@ -0,0 +1,71 @@
+#ifndef STM8_CAPTURE_H_
+#define STM8_CAPTURE_H_
+
+/*
+ * Input capture timestamps on TIM1, extended to 32 bits
+ *
+ * The update interrupt counts the overflows of the 16-bit counter, the
+ * capture interrupt combines them with each captured value and queues the
+ * timestamp (in TIM1 counter clocks) with its channel. A capture taken just
+ * after an overflow whose update interrupt hasn't run yet (update flag set,
+ * captured value in the lower half) is counted in the next period, a capture
+ * taken just before an overflow already counted (no update pending, captured
+ * value in the upper half, counter in the lower half) in the previous one.
+ * The capture interrupt latency must stay below half a counter period.
+ *
+ * Configure the TIM1 prescaler (TIM1_TimeBaseInit, the period is set to
+ * 0xFFFF) and the capture channels (TIM1_ICInit), enable the clock of TIM1 on
+ * STM8L15x, then call Capture_Init() and enable interrupts.
+ * Include this header in the file with main() so SDCC generates the vectors.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#elif defined(STM8_FAMILY_L10X)
+#error "TIM1 is not available on STM8L10x"
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+#include "stm8_it.h"
+
+#if defined(STM8_FAMILY_L15X)
+#if defined(STM8L15X_LD) || defined(STM8L05X_LD_VL)
+#error "TIM1 is not available on STM8L15x low density devices"
+#endif
+#define CAPTURE_UPDATE_IRQHandler  TIM1_OVF_TRG_COM_IRQHandler
+#else
+#define CAPTURE_UPDATE_IRQHandler  TIM1_UPD_OVF_TRG_BRK_IRQHandler
+#endif
+#define CAPTURE_CAPTURE_IRQHandler TIM1_CAP_COM_IRQHandler
+
+//Timestamps in the queue, power of 2 up to 128
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE 16
+#endif
+
+//Channels of Capture_Init(), can be combined
+#define CAPTURE_CHANNEL_1 ((uint8_t)0x02)
+#define CAPTURE_CHANNEL_2 ((uint8_t)0x04)
+#define CAPTURE_CHANNEL_3 ((uint8_t)0x08)
+#define CAPTURE_CHANNEL_4 ((uint8_t)0x10)
+
+typedef struct
+{
+  uint32_t Time;   /* TIM1 counter clocks since Capture_Init(), wraps */
+  uint8_t Channel; /* 1 to 4 */
+} Capture_Event_TypeDef;
+
+void Capture_Init(uint8_t Channels);
+//Returns 0 when the queue is empty
+uint8_t Capture_Read(Capture_Event_TypeDef* Event);
+//Current time on the timeline of the timestamps
+uint32_t Capture_Now(void);
+//Edges lost by a full queue or an overcapture (edge before the previous one was read)
+uint16_t Capture_GetLost(void);
+
+CAPTURE_UPDATE_IRQHandler();
+CAPTURE_CAPTURE_IRQHandler();
+
+#endif //STM8_CAPTURE_H_
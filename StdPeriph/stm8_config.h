@@ -0,0 +1,89 @@
+#ifndef STM8_CONFIG_H_
+#define STM8_CONFIG_H_
+
+/*
+ * Peripheral initialization with constant arguments (SDCC)
+ *
+ * The StdPeriph init functions take their arguments at run time and build the
+ * register values with read/modify/write sequences. These macros take the
+ * same driver constants and compute the register values at compile time: a
+ * configuration is a few mov (or bset/bres) instructions and no call.
+ * Arguments must be constants, they are evaluated several times.
+ *
+ * Registers written whole start from their reset value: use the macros
+ * before the peripheral is enabled.
+ *
+ * Include the family header (stm8s.h, stm8l15x.h or stm8l10x.h) first.
+ */
+
+//GPIO_Init(): with a single pin each register is one bset or bres
+#define GPIO_CONFIG(PORT, PINS, MODE) \
+    do { \
+        (PORT)->CR2 &= (uint8_t)~(uint8_t)(PINS); \
+        if(((uint8_t)(MODE) & 0x80) && ((uint8_t)(MODE) & 0x10)) \
+            (PORT)->ODR |= (uint8_t)(PINS); \
+        else if((uint8_t)(MODE) & 0x80) \
+            (PORT)->ODR &= (uint8_t)~(uint8_t)(PINS); \
+        if((uint8_t)(MODE) & 0x80) \
+            (PORT)->DDR |= (uint8_t)(PINS); \
+        else \
+            (PORT)->DDR &= (uint8_t)~(uint8_t)(PINS); \
+        if((uint8_t)(MODE) & 0x40) \
+            (PORT)->CR1 |= (uint8_t)(PINS); \
+        else \
+            (PORT)->CR1 &= (uint8_t)~(uint8_t)(PINS); \
+        if((uint8_t)(MODE) & 0x20) \
+            (PORT)->CR2 |= (uint8_t)(PINS); \
+    } while(0)
+
+//Bits of the pins whose GPIO_Mode_TypeDef value has BIT set
+#define GPIO_CONFIG_BITS(BIT, M0, M1, M2, M3, M4, M5, M6, M7) \
+    ((uint8_t)((((uint8_t)(M0) & (BIT)) ? 0x01 : 0) | (((uint8_t)(M1) & (BIT)) ? 0x02 : 0) | \
+               (((uint8_t)(M2) & (BIT)) ? 0x04 : 0) | (((uint8_t)(M3) & (BIT)) ? 0x08 : 0) | \
+               (((uint8_t)(M4) & (BIT)) ? 0x10 : 0) | (((uint8_t)(M5) & (BIT)) ? 0x20 : 0) | \
+               (((uint8_t)(M6) & (BIT)) ? 0x40 : 0) | (((uint8_t)(M7) & (BIT)) ? 0x80 : 0)))
+
+//GPIO_Init() of the 8 pins of PORT, M0 is the mode of pin 0: 5 register writes
+#define GPIO_CONFIG_PORT(PORT, M0, M1, M2, M3, M4, M5, M6, M7) \
+    do { \
+        (PORT)->CR2 = 0; \
+        (PORT)->ODR = GPIO_CONFIG_BITS(0x10, M0, M1, M2, M3, M4, M5, M6, M7) & \
+                      GPIO_CONFIG_BITS(0x80, M0, M1, M2, M3, M4, M5, M6, M7); \
+        (PORT)->DDR = GPIO_CONFIG_BITS(0x80, M0, M1, M2, M3, M4, M5, M6, M7); \
+        (PORT)->CR1 = GPIO_CONFIG_BITS(0x40, M0, M1, M2, M3, M4, M5, M6, M7); \
+        (PORT)->CR2 = GPIO_CONFIG_BITS(0x20, M0, M1, M2, M3, M4, M5, M6, M7); \
+    } while(0)
+
+//SPI_Init() without CRC (CRCPR keeps its reset value), SPIx is SPI on STM8S and STM8L10x.
+//SSI is set in CR2 before MSTR in CR1.
+#define SPI_CONFIG(SPIx, FIRSTBIT, PRESCALER, MODE, CPOL, CPHA, DIRECTION, NSS) \
+    do { \
+        (SPIx)->CR2 = (uint8_t)((uint8_t)(DIRECTION) | (uint8_t)(NSS) | \
+                                (((uint8_t)(MODE) & SPI_CR1_MSTR) ? SPI_CR2_SSI : 0)); \
+        (SPIx)->CR1 = (uint8_t)((uint8_t)(FIRSTBIT) | (uint8_t)(PRESCALER) | (uint8_t)(CPOL) | \
+                                (uint8_t)(CPHA) | (uint8_t)(MODE)); \
+    } while(0)
+
+#if defined(TIM1_CR1_CMS)
+//TIM1_TimeBaseInit(), CR1 is written whole
+#define TIM1_TIMEBASE_CONFIG(PRESCALER, COUNTERMODE, PERIOD, REPETITION) \
+    do { \
+        TIM1->ARRH = (uint8_t)((uint16_t)(PERIOD) >> 8); \
+        TIM1->ARRL = (uint8_t)(PERIOD); \
+        TIM1->PSCRH = (uint8_t)((uint16_t)(PRESCALER) >> 8); \
+        TIM1->PSCRL = (uint8_t)(PRESCALER); \
+        TIM1->CR1 = (uint8_t)(COUNTERMODE); \
+        TIM1->RCR = (uint8_t)(REPETITION); \
+    } while(0)
+#endif
+
+#if defined(ADC_CR1_RES)
+//STM8L15x ADC_Init(), CR1 and CR2 are written whole (ADC off, no trigger, sampling time 0)
+#define ADC_CONFIG(ADCx, CONVERSIONMODE, RESOLUTION, PRESCALER) \
+    do { \
+        (ADCx)->CR1 = (uint8_t)((uint8_t)(CONVERSIONMODE) | (uint8_t)(RESOLUTION)); \
+        (ADCx)->CR2 = (uint8_t)(PRESCALER); \
+    } while(0)
+#endif
+
+#endif //STM8_CONFIG_H_
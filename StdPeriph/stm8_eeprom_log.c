@@ -0,0 +1,136 @@
+#include "stm8_eeprom_log.h"
+
+/* The driver's sizes are casts, not usable in #if: a negative array size
+   fails the build instead */
+typedef char EEPROM_Log_BlocksCheck[(EEPROM_LOG_BLOCKS >= 2 &&
+                                     EEPROM_LOG_FIRST_BLOCK + EEPROM_LOG_BLOCKS <= EEPROM_LOG_DATA_BLOCKS) ? 1 : -1];
+typedef char EEPROM_Log_RecordCheck[(EEPROM_LOG_RECORD_SIZE <= EEPROM_LOG_RECORD_MAX) ? 1 : -1];
+
+#if defined(STM8_FAMILY_S)
+#define EEPROM_LOG_MEMTYPE  FLASH_MEMTYPE_DATA
+#define EEPROM_LOG_PROGMODE FLASH_PROGRAMMODE_STANDARD
+#else
+#define EEPROM_LOG_MEMTYPE  FLASH_MemType_Data
+#define EEPROM_LOG_PROGMODE FLASH_ProgramMode_Standard
+#endif
+
+/* Block layout: sequence number (MSB first), record, checksum (MSB first) */
+#define EEPROM_LOG_CHECKSUM (FLASH_BLOCK_SIZE - 2)
+
+#define EEPROM_LOG_BLOCK(N) \
+  ((const uint8_t*)(uint16_t)(EEPROM_LOG_DATA_START + (uint16_t)(EEPROM_LOG_FIRST_BLOCK + (N)) * FLASH_BLOCK_SIZE))
+
+static uint8_t Newest;
+static uint16_t Sequence;
+static uint8_t Valid;
+static uint8_t Buffer[FLASH_BLOCK_SIZE];
+
+/* Complemented Fletcher-16 (modulo 256) of the block less the checksum, so
+   that an erased block (all 0) is invalid */
+static uint16_t EEPROM_Log_Checksum(const uint8_t* Block)
+{
+  uint8_t sum1 = 0;
+  uint8_t sum2 = 0;
+  uint8_t i;
+
+  for (i = 0; i < EEPROM_LOG_CHECKSUM; i++)
+  {
+    sum1 += Block[i];
+    sum2 += sum1;
+  }
+  return (uint16_t)~(uint16_t)(((uint16_t)sum2 << 8) | sum1);
+}
+
+static uint8_t EEPROM_Log_IsValid(const uint8_t* Block)
+{
+  return (uint8_t)(EEPROM_Log_Checksum(Block) ==
+                   (uint16_t)(((uint16_t)Block[EEPROM_LOG_CHECKSUM] << 8) | Block[EEPROM_LOG_CHECKSUM + 1]));
+}
+
+uint8_t EEPROM_Log_Init(void)
+{
+  const uint8_t* block;
+  uint16_t sequence;
+  uint8_t n;
+
+  Valid = 0;
+  Newest = EEPROM_LOG_BLOCKS - 1;
+  Sequence = 0;
+  for (n = 0; n < EEPROM_LOG_BLOCKS; n++)
+  {
+    block = EEPROM_LOG_BLOCK(n);
+    if (!EEPROM_Log_IsValid(block))
+    {
+      continue;
+    }
+    sequence = (uint16_t)(((uint16_t)block[0] << 8) | block[1]);
+    //Sequence numbers wrap, valid ones are less than EEPROM_LOG_BLOCKS apart
+    if (!Valid || (int16_t)(sequence - Sequence) > 0)
+    {
+      Valid = 1;
+      Newest = n;
+      Sequence = sequence;
+    }
+  }
+  return Valid;
+}
+
+uint8_t EEPROM_Log_Read(void* Record)
+{
+  const uint8_t* block = EEPROM_LOG_BLOCK(Newest);
+  uint8_t* record = (uint8_t*)Record;
+  uint8_t i;
+
+  if (!Valid)
+  {
+    return 0;
+  }
+  for (i = 0; i < EEPROM_LOG_RECORD_SIZE; i++)
+  {
+    record[i] = block[i + 2];
+  }
+  return 1;
+}
+
+uint8_t EEPROM_Log_Write(const void* Record)
+{
+  const uint8_t* record = (const uint8_t*)Record;
+  uint16_t sequence = (uint16_t)(Sequence + 1);
+  uint16_t checksum;
+  uint8_t next = (uint8_t)(Newest + 1);
+  uint8_t i;
+
+  if (next == EEPROM_LOG_BLOCKS)
+  {
+    next = 0;
+  }
+
+  Buffer[0] = (uint8_t)(sequence >> 8);
+  Buffer[1] = (uint8_t)sequence;
+  for (i = 0; i < EEPROM_LOG_RECORD_SIZE; i++)
+  {
+    Buffer[i + 2] = record[i];
+  }
+  for (i += 2; i < EEPROM_LOG_CHECKSUM; i++)
+  {
+    Buffer[i] = 0;
+  }
+  checksum = EEPROM_Log_Checksum(Buffer);
+  Buffer[EEPROM_LOG_CHECKSUM] = (uint8_t)(checksum >> 8);
+  Buffer[EEPROM_LOG_CHECKSUM + 1] = (uint8_t)checksum;
+
+  FLASH_Unlock(EEPROM_LOG_MEMTYPE);
+  FLASH_ProgramBlock((uint16_t)(EEPROM_LOG_FIRST_BLOCK + next), EEPROM_LOG_MEMTYPE, EEPROM_LOG_PROGMODE, Buffer);
+  FLASH_WaitForLastOperation(EEPROM_LOG_MEMTYPE);
+  FLASH_Lock(EEPROM_LOG_MEMTYPE);
+
+  //The newest record stays the previous one when the block is bad
+  if (!EEPROM_Log_IsValid(EEPROM_LOG_BLOCK(next)))
+  {
+    return 0;
+  }
+  Valid = 1;
+  Newest = next;
+  Sequence = sequence;
+  return 1;
+}
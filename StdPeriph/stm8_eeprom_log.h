@@ -0,0 +1,54 @@
+#ifndef STM8_EEPROM_LOG_H_
+#define STM8_EEPROM_LOG_H_
+
+/*
+ * Wear leveled record store in the data EEPROM (STM8S, STM8L15x)
+ *
+ * Each EEPROM_Log_Write() programs the record into the next block of the
+ * log area with one FLASH_ProgramBlock() (one erase/program cycle for the
+ * whole record instead of one per byte), with a sequence number and a
+ * checksum. Blocks are used in turn, so each one wears EEPROM_LOG_BLOCKS
+ * times slower. EEPROM_Log_Init() finds the valid block with the newest
+ * sequence number: a write interrupted by a reset fails its checksum and the
+ * previous record is still there.
+ *
+ * FLASH_ProgramBlock() must run from RAM on devices without read-while-write
+ * on the data EEPROM, see "Execution from RAM" in README.md.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#include <stm8s_flash.h>
+#define EEPROM_LOG_DATA_START  FLASH_DATA_START_PHYSICAL_ADDRESS
+#define EEPROM_LOG_DATA_BLOCKS FLASH_DATA_BLOCKS_NUMBER
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#include <stm8l15x_flash.h>
+#define EEPROM_LOG_DATA_START  FLASH_DATA_EEPROM_START_PHYSICAL_ADDRESS
+#define EEPROM_LOG_DATA_BLOCKS FLASH_DATA_EEPROM_BLOCKS_NUMBER
+#else
+#error "The EEPROM log needs the data EEPROM of STM8S or STM8L15x"
+#endif
+
+//Log area: EEPROM_LOG_BLOCKS data EEPROM blocks from EEPROM_LOG_FIRST_BLOCK, all by default
+#ifndef EEPROM_LOG_FIRST_BLOCK
+#define EEPROM_LOG_FIRST_BLOCK 0
+#endif
+#ifndef EEPROM_LOG_BLOCKS
+#define EEPROM_LOG_BLOCKS (EEPROM_LOG_DATA_BLOCKS - EEPROM_LOG_FIRST_BLOCK)
+#endif
+
+//Record size in bytes, up to a block less the sequence number and checksum
+#define EEPROM_LOG_RECORD_MAX (FLASH_BLOCK_SIZE - 4)
+#ifndef EEPROM_LOG_RECORD_SIZE
+#define EEPROM_LOG_RECORD_SIZE EEPROM_LOG_RECORD_MAX
+#endif
+
+//Returns 1 when the log holds a record
+uint8_t EEPROM_Log_Init(void);
+//Copies the newest record (EEPROM_LOG_RECORD_SIZE bytes), returns 0 when there is none
+uint8_t EEPROM_Log_Read(void* Record);
+//Appends Record, returns 0 when the block doesn't read back correctly
+uint8_t EEPROM_Log_Write(const void* Record);
+
+#endif //STM8_EEPROM_LOG_H_
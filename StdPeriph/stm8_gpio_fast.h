@@ -0,0 +1,33 @@
+#ifndef STM8_GPIO_FAST_H_
+#define STM8_GPIO_FAST_H_
+
+/*
+ * Inline GPIO access for constant ports and pins (SDCC)
+ *
+ * GPIO_SetBits() and friends are out of line calls taking the port pointer as
+ * an argument. With a constant port (GPIOA...) and a single pin mask
+ * (GPIO_Pin_x / GPIO_PIN_x) SDCC compiles these macros to one bset, bres or
+ * bcpl instruction on the ODR register, and GPIO_FAST_READ() to btjt/btjf when
+ * used in a condition. A mask of several pins is a load/modify/store, which is
+ * not atomic against interrupts writing the same port.
+ *
+ * Include the family header (stm8s.h, stm8l15x.h or stm8l10x.h) first.
+ */
+
+#define GPIO_FAST_SET(PORT, PINS)       ((PORT)->ODR |= (uint8_t)(PINS))
+#define GPIO_FAST_RESET(PORT, PINS)     ((PORT)->ODR &= (uint8_t)~(uint8_t)(PINS))
+#define GPIO_FAST_TOGGLE(PORT, PINS)    ((PORT)->ODR ^= (uint8_t)(PINS))
+
+//VAL is folded when constant, otherwise it is a test and a bset or bres
+#define GPIO_FAST_WRITE(PORT, PINS, VAL) \
+    do { \
+        if(VAL) \
+            GPIO_FAST_SET(PORT, PINS); \
+        else \
+            GPIO_FAST_RESET(PORT, PINS); \
+    } while(0)
+
+//Non zero when any of PINS is high
+#define GPIO_FAST_READ(PORT, PINS)      ((PORT)->IDR & (uint8_t)(PINS))
+
+#endif //STM8_GPIO_FAST_H_
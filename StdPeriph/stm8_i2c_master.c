@@ -0,0 +1,314 @@
+#include "stm8_i2c_master.h"
+
+#if defined(STM8_FAMILY_L15X)
+#define I2C_MASTER_PORT I2C1
+#else
+#define I2C_MASTER_PORT I2C
+#endif
+
+//I2C pins, driven as GPIO during bus recovery
+#if defined(STM8_FAMILY_S)
+#define I2C_MASTER_GPIO GPIOB
+#define I2C_MASTER_SCL  ((uint8_t)0x10)
+#define I2C_MASTER_SDA  ((uint8_t)0x20)
+#else
+#define I2C_MASTER_GPIO GPIOC
+#define I2C_MASTER_SCL  ((uint8_t)0x02)
+#define I2C_MASTER_SDA  ((uint8_t)0x01)
+#endif
+
+#define I2C_MASTER_SR2_ERRORS (uint8_t)(I2C_SR2_AF | I2C_SR2_ARLO | I2C_SR2_BERR | I2C_SR2_OVR)
+
+/* Queue of transactions, Current is running and links to the next ones. Only
+   modified in critical sections or in the I2C interrupt. */
+static I2C_Master_Transaction_TypeDef* volatile Current;
+static I2C_Master_Transaction_TypeDef* Last;
+static uint8_t Receiving;
+/* Repeated START requested: BTF and TXE stay set until it is generated, only
+   SB is handled meanwhile */
+static uint8_t Restarting;
+static uint8_t Index;
+static volatile uint8_t Timer;
+
+static void I2C_Master_Delay(void)
+{
+  volatile uint8_t i;
+
+  for (i = 0; i < I2C_MASTER_RECOVERY_DELAY; i++)
+  {
+  }
+}
+
+/* A pending STOP must be sent before CR2 is written again */
+static void I2C_Master_WaitStop(void)
+{
+  uint8_t i = 0xFF;
+
+  while ((I2C_MASTER_PORT->CR2 & I2C_CR2_STOP) && --i)
+  {
+  }
+}
+
+static void I2C_Master_Start(void)
+{
+  I2C_Master_Transaction_TypeDef* t = Current;
+
+  if (t == 0)
+  {
+    return;
+  }
+  t->Status = I2C_MASTER_BUSY;
+  Receiving = (uint8_t)(t->TxLength == 0 && t->RxLength != 0);
+  Restarting = 0;
+  Index = 0;
+  Timer = I2C_MASTER_TIMEOUT;
+  I2C_Master_WaitStop();
+  I2C_MASTER_PORT->ITR = (uint8_t)(I2C_ITR_ITEVTEN | I2C_ITR_ITBUFEN | I2C_ITR_ITERREN);
+  I2C_MASTER_PORT->CR2 = (uint8_t)((I2C_MASTER_PORT->CR2 & (uint8_t)~I2C_CR2_POS) | I2C_CR2_START);
+}
+
+/* Completes the current transaction and starts the next one */
+static void I2C_Master_Finish(I2C_Master_Status_TypeDef Status)
+{
+  I2C_Master_Transaction_TypeDef* t = Current;
+
+  I2C_MASTER_PORT->ITR = 0;
+  Current = t->Next;
+  t->Status = Status;
+  if (t->Callback)
+  {
+    t->Callback(t);
+  }
+  I2C_Master_Start();
+}
+
+void I2C_Master_Init(void)
+{
+  Current = 0;
+  Last = 0;
+  I2C_MASTER_PORT->ITR = 0;
+}
+
+void I2C_Master_Submit(I2C_Master_Transaction_TypeDef* Transaction)
+{
+  Transaction->Status = I2C_MASTER_QUEUED;
+  Transaction->Next = 0;
+  __critical
+  {
+    if (Current == 0)
+    {
+      Current = Transaction;
+      Last = Transaction;
+      I2C_Master_Start();
+    }
+    else
+    {
+      Last->Next = Transaction;
+      Last = Transaction;
+    }
+  }
+}
+
+uint8_t I2C_Master_IsBusy(void)
+{
+  return (uint8_t)(Current != 0);
+}
+
+void I2C_Master_Tick(void)
+{
+  __critical
+  {
+    if (Current != 0 && --Timer == 0)
+    {
+      I2C_MASTER_PORT->ITR = 0;
+      I2C_Master_Recover();
+      I2C_Master_Finish(I2C_MASTER_TIMEOUT_ERROR);
+    }
+  }
+}
+
+/* Disabling the I2C resets its state and hands the pins to the GPIO (true open
+   drain), SCL is pulsed until the slave releases SDA and a STOP ends its
+   transfer */
+void I2C_Master_Recover(void)
+{
+  uint8_t i;
+
+  I2C_MASTER_PORT->CR1 &= (uint8_t)~I2C_CR1_PE;
+  I2C_MASTER_GPIO->ODR |= (uint8_t)(I2C_MASTER_SCL | I2C_MASTER_SDA);
+  I2C_MASTER_GPIO->DDR |= I2C_MASTER_SCL;
+  for (i = 0; i < 9 && !(I2C_MASTER_GPIO->IDR & I2C_MASTER_SDA); i++)
+  {
+    I2C_MASTER_GPIO->ODR &= (uint8_t)~I2C_MASTER_SCL;
+    I2C_Master_Delay();
+    I2C_MASTER_GPIO->ODR |= I2C_MASTER_SCL;
+    I2C_Master_Delay();
+  }
+  I2C_MASTER_GPIO->ODR &= (uint8_t)~I2C_MASTER_SCL;
+  I2C_Master_Delay();
+  I2C_MASTER_GPIO->ODR &= (uint8_t)~I2C_MASTER_SDA;
+  I2C_MASTER_GPIO->DDR |= I2C_MASTER_SDA;
+  I2C_Master_Delay();
+  I2C_MASTER_GPIO->ODR |= I2C_MASTER_SCL;
+  I2C_Master_Delay();
+  I2C_MASTER_GPIO->ODR |= I2C_MASTER_SDA;
+  I2C_Master_Delay();
+  I2C_MASTER_GPIO->DDR &= (uint8_t)~(I2C_MASTER_SCL | I2C_MASTER_SDA);
+  I2C_MASTER_PORT->CR1 |= I2C_CR1_PE;
+}
+
+/* Master reception follows the reference manual: a single byte is NACKed
+   and stopped when the address is acknowledged, two bytes use POS, longer
+   transfers stop on BTF with the last 3 bytes left */
+static void I2C_Master_ReceiveEvent(I2C_Master_Transaction_TypeDef* t, uint8_t SR1)
+{
+  uint8_t remaining = (uint8_t)(t->RxLength - Index);
+
+  if (t->RxLength == 2)
+  {
+    if (SR1 & I2C_SR1_BTF)
+    {
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_STOP;
+      t->RxData[0] = I2C_MASTER_PORT->DR;
+      t->RxData[1] = I2C_MASTER_PORT->DR;
+      I2C_Master_Finish(I2C_MASTER_DONE);
+    }
+  }
+  else if (remaining == 3)
+  {
+    if (SR1 & I2C_SR1_BTF)
+    {
+      I2C_MASTER_PORT->CR2 &= (uint8_t)~I2C_CR2_ACK;
+      t->RxData[Index++] = I2C_MASTER_PORT->DR;
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_STOP;
+      t->RxData[Index++] = I2C_MASTER_PORT->DR;
+      I2C_MASTER_PORT->ITR |= I2C_ITR_ITBUFEN;
+    }
+  }
+  else if (SR1 & I2C_SR1_RXNE)
+  {
+    t->RxData[Index++] = I2C_MASTER_PORT->DR;
+    if (remaining == 1)
+    {
+      I2C_Master_Finish(I2C_MASTER_DONE);
+    }
+    else if (remaining == 4)
+    {
+      //Wait for BTF with the last 3 bytes left
+      I2C_MASTER_PORT->ITR &= (uint8_t)~I2C_ITR_ITBUFEN;
+    }
+  }
+}
+
+I2C_IRQHandler()
+{
+  I2C_Master_Transaction_TypeDef* t = Current;
+  uint8_t sr1;
+  uint8_t sr2 = I2C_MASTER_PORT->SR2;
+
+  if (t == 0)
+  {
+    I2C_MASTER_PORT->ITR = 0;
+    return;
+  }
+
+  if (sr2 & I2C_MASTER_SR2_ERRORS)
+  {
+    I2C_MASTER_PORT->SR2 = 0;
+    if (sr2 & I2C_SR2_AF)
+    {
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_STOP;
+      I2C_Master_Finish(I2C_MASTER_NACK);
+    }
+    else if (sr2 & I2C_SR2_ARLO)
+    {
+      I2C_Master_Finish(I2C_MASTER_ARBITRATION_LOST);
+    }
+    else
+    {
+      I2C_MASTER_PORT->ITR = 0;
+      I2C_Master_Recover();
+      I2C_Master_Finish(I2C_MASTER_BUS_ERROR);
+    }
+    return;
+  }
+
+  sr1 = I2C_MASTER_PORT->SR1;
+  if (sr1 & I2C_SR1_SB)
+  {
+    //Reading SR1 then writing DR clears SB
+    Restarting = 0;
+    I2C_MASTER_PORT->DR = (uint8_t)((uint8_t)(t->Address << 1) | Receiving);
+  }
+  else if (Restarting)
+  {
+    //Stale BTF of the write phase
+  }
+  else if (sr1 & I2C_SR1_ADDR)
+  {
+    //Reading SR1 then SR3 clears ADDR
+    if (!Receiving)
+    {
+      (void)I2C_MASTER_PORT->SR3;
+    }
+    else if (t->RxLength == 1)
+    {
+      I2C_MASTER_PORT->CR2 &= (uint8_t)~I2C_CR2_ACK;
+      (void)I2C_MASTER_PORT->SR3;
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_STOP;
+      I2C_MASTER_PORT->ITR |= I2C_ITR_ITBUFEN;
+    }
+    else if (t->RxLength == 2)
+    {
+      I2C_MASTER_PORT->CR2 |= (uint8_t)(I2C_CR2_POS | I2C_CR2_ACK);
+      (void)I2C_MASTER_PORT->SR3;
+      I2C_MASTER_PORT->CR2 &= (uint8_t)~I2C_CR2_ACK;
+      I2C_MASTER_PORT->ITR &= (uint8_t)~I2C_ITR_ITBUFEN;
+    }
+    else
+    {
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_ACK;
+      (void)I2C_MASTER_PORT->SR3;
+      if (t->RxLength == 3)
+      {
+        I2C_MASTER_PORT->ITR &= (uint8_t)~I2C_ITR_ITBUFEN;
+      }
+      else
+      {
+        I2C_MASTER_PORT->ITR |= I2C_ITR_ITBUFEN;
+      }
+    }
+  }
+  else if (Receiving)
+  {
+    I2C_Master_ReceiveEvent(t, sr1);
+  }
+  else if (Index < t->TxLength)
+  {
+    if (sr1 & I2C_SR1_TXE)
+    {
+      I2C_MASTER_PORT->DR = t->TxData[Index++];
+      if (Index == t->TxLength)
+      {
+        //Wait for BTF, the last byte is sent
+        I2C_MASTER_PORT->ITR &= (uint8_t)~I2C_ITR_ITBUFEN;
+      }
+    }
+  }
+  else if (sr1 & (I2C_SR1_BTF | I2C_SR1_TXE))
+  {
+    if (t->RxLength != 0)
+    {
+      //RXNE interrupts are enabled again by ADDR
+      Receiving = 1;
+      Restarting = 1;
+      Index = 0;
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_START;
+    }
+    else
+    {
+      I2C_MASTER_PORT->CR2 |= I2C_CR2_STOP;
+      I2C_Master_Finish(I2C_MASTER_DONE);
+    }
+  }
+}
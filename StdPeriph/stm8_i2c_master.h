@@ -0,0 +1,81 @@
+#ifndef STM8_I2C_MASTER_H_
+#define STM8_I2C_MASTER_H_
+
+/*
+ * Interrupt driven I2C master with a transaction queue: I2C on STM8S and
+ * STM8L10x, I2C1 on STM8L15x
+ *
+ * Configure the I2C with the StdPeriph driver (I2C_Init), call
+ * I2C_Master_Init() and enable interrupts. I2C_Master_Submit() queues a
+ * transaction and returns, the I2C interrupt runs the START/address/data/STOP
+ * sequence of each transaction in turn and calls its callback (in interrupt
+ * context) when it completes or fails. A transaction writes TxLength bytes,
+ * reads RxLength bytes, or writes then reads after a repeated START (register
+ * reads). Transactions are owned by the caller and must not be modified until
+ * completed.
+ *
+ * Call I2C_Master_Tick() periodically (e.g. from a 1 ms timer interrupt): a
+ * transaction still running after I2C_MASTER_TIMEOUT ticks is aborted, the bus
+ * is recovered (up to 9 SCL pulses to release SDA, then a STOP) and the next
+ * transaction starts.
+ * Include this header in the file with main() so SDCC generates the vector.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+#include "stm8_it.h"
+
+//Ticks of I2C_Master_Tick() before a transaction is aborted
+#ifndef I2C_MASTER_TIMEOUT
+#define I2C_MASTER_TIMEOUT 10
+#endif
+
+//Busy loop iterations per half SCL period during bus recovery
+#ifndef I2C_MASTER_RECOVERY_DELAY
+#define I2C_MASTER_RECOVERY_DELAY 20
+#endif
+
+typedef enum
+{
+  I2C_MASTER_QUEUED,            /* Waiting in the queue */
+  I2C_MASTER_BUSY,              /* Running */
+  I2C_MASTER_DONE,              /* Completed */
+  I2C_MASTER_NACK,              /* Address or data byte not acknowledged */
+  I2C_MASTER_BUS_ERROR,         /* Misplaced START or STOP, bus recovered */
+  I2C_MASTER_ARBITRATION_LOST,  /* Another master took the bus */
+  I2C_MASTER_TIMEOUT_ERROR      /* Aborted by I2C_Master_Tick(), bus recovered */
+} I2C_Master_Status_TypeDef;
+
+typedef struct I2C_Master_Transaction I2C_Master_Transaction_TypeDef;
+
+struct I2C_Master_Transaction
+{
+  uint8_t Address;              /* 7-bit slave address */
+  const uint8_t* TxData;        /* Bytes written first */
+  uint8_t TxLength;
+  uint8_t* RxData;              /* Bytes read next, after a repeated START when TxLength is not 0 */
+  uint8_t RxLength;
+  void (*Callback)(I2C_Master_Transaction_TypeDef* Transaction); /* Called on completion, may be 0 */
+  volatile I2C_Master_Status_TypeDef Status;
+  I2C_Master_Transaction_TypeDef* Next;                          /* Queue link */
+};
+
+void I2C_Master_Init(void);
+//Queues Transaction, it starts at once when the queue is empty
+void I2C_Master_Submit(I2C_Master_Transaction_TypeDef* Transaction);
+//Non zero while transactions are queued or running
+uint8_t I2C_Master_IsBusy(void);
+void I2C_Master_Tick(void);
+//Releases a slave holding SDA low, the I2C must not be running a transaction
+void I2C_Master_Recover(void);
+
+I2C_IRQHandler();
+
+#endif //STM8_I2C_MASTER_H_
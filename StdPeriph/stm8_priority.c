@@ -0,0 +1,63 @@
+#include "stm8_priority.h"
+
+//CC.I1 and CC.I0
+#define PRIORITY_CC_I ((uint8_t)0x28)
+#define PRIORITY_CC(LEVEL) ((uint8_t)((((LEVEL) & 0x02) << 4) | (((LEVEL) & 0x01) << 3)))
+
+/* Order of the levels: I1/I0 10 is level 0 (main), 01 level 1, 00 level 2,
+   11 level 3 */
+static const uint8_t Rank[4] = { 2, 1, 0, 3 };
+
+static uint8_t Priority_GetState(void) __naked
+{
+  __asm
+    push    cc
+    pop     a
+    ret
+  __endasm;
+}
+
+/* Writes CC: the I1/I0 bits can be written by pop cc, the flags don't matter
+   on return */
+void Priority_Restore(uint8_t State) __naked
+{
+  (void)State;
+  __asm
+#if defined(__SDCCCALL) && __SDCCCALL != 0
+    push    a
+#else
+    ld      a, (3, sp)
+    push    a
+#endif
+    pop     cc
+    ret
+  __endasm;
+}
+
+uint8_t Priority_Raise(uint8_t Level)
+{
+  uint8_t state = Priority_GetState();
+  uint8_t current = (uint8_t)(((state >> 4) & 0x02) | ((state >> 3) & 0x01));
+
+  if (Rank[current] < Rank[Level & 0x03])
+  {
+    Priority_Restore((uint8_t)((state & (uint8_t)~PRIORITY_CC_I) | PRIORITY_CC(Level)));
+  }
+  return state;
+}
+
+/* The ITC priorities can only be written with interrupts masked */
+void Priority_Configure(const Priority_Plan_TypeDef* Plan, uint8_t Count)
+{
+  volatile uint8_t* ispr = &ITC->ISPR1;
+  uint8_t state = Priority_Raise(PRIORITY_LEVEL_3);
+  uint8_t shift;
+
+  for (; Count != 0; Count--, Plan++)
+  {
+    shift = (uint8_t)((Plan->Irq & 0x03) << 1);
+    ispr[Plan->Irq >> 2] = (uint8_t)((ispr[Plan->Irq >> 2] & (uint8_t)~(uint8_t)(0x03 << shift)) |
+                                     (uint8_t)((Plan->Level & 0x03) << shift));
+  }
+  Priority_Restore(state);
+}
@@ -0,0 +1,47 @@
+#ifndef STM8_PRIORITY_H_
+#define STM8_PRIORITY_H_
+
+/*
+ * Interrupt priority plan and priority critical sections (SDCC)
+ *
+ * Priority_Configure() writes the software priority of each interrupt of a
+ * constant plan into the ITC, in one pass at boot. Data shared with interrupts
+ * of priority up to LEVEL is protected by raising the CPU priority (CC.I1/I0)
+ * to LEVEL instead of masking all interrupts:
+ *
+ *   uint8_t state = Priority_Raise(PRIORITY_LEVEL_2);
+ *   ...
+ *   Priority_Restore(state);
+ *
+ * Interrupts of a higher software priority still preempt the section.
+ * Sections nest, Priority_Raise() never lowers the current priority.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+
+//Software priority levels, the ITC_PriorityLevel_TypeDef values and CC.I1/I0 bits
+#define PRIORITY_LEVEL_1 ((uint8_t)0x01)
+#define PRIORITY_LEVEL_2 ((uint8_t)0x00)
+#define PRIORITY_LEVEL_3 ((uint8_t)0x03) //All maskable interrupts masked
+
+typedef struct
+{
+  uint8_t Irq;   //IRQ number (ITC_Irq_TypeDef, IRQn_TypeDef)
+  uint8_t Level; //PRIORITY_LEVEL_1 to PRIORITY_LEVEL_3
+} Priority_Plan_TypeDef;
+
+//Sets the software priority of Count interrupts, with interrupts masked
+void Priority_Configure(const Priority_Plan_TypeDef* Plan, uint8_t Count);
+//Raises the CPU priority to at least Level, returns the state for Priority_Restore()
+uint8_t Priority_Raise(uint8_t Level);
+void Priority_Restore(uint8_t State);
+
+#endif //STM8_PRIORITY_H_
@@ -0,0 +1,72 @@
+#include "stm8_pwm_sequencer.h"
+
+#if defined(STM8_FAMILY_L15X)
+#include <stm8l15x_clk.h>
+#include <stm8l15x_dma.h>
+#include <stm8l15x_tim1.h>
+
+#define PWM_SEQUENCER_DMA_CHANNEL DMA1_Channel3
+
+/* Each update request starts a burst of 2 * Channels bytes to TIM1_DMAR, which
+   the timer redirects to CCR1H, CCR1L, CCR2H... The circular transfer starts
+   over at the end of the table. */
+void PWM_Sequencer_Start(const uint16_t* Table, uint8_t Steps, uint8_t Channels)
+{
+  uint8_t burst = (uint8_t)(Channels * 2);
+
+  PWM_Sequencer_Stop();
+  CLK_PeripheralClockConfig(CLK_Peripheral_DMA1, ENABLE);
+  DMA_Init(PWM_SEQUENCER_DMA_CHANNEL, (uint32_t)(uint16_t)Table, (uint16_t)&TIM1->DMAR,
+           (uint8_t)(Steps * burst), DMA_DIR_MemoryToPeripheral, DMA_Mode_Circular,
+           DMA_MemoryIncMode_Inc, DMA_Priority_High, DMA_MemoryDataSize_Byte);
+  DMA_Cmd(PWM_SEQUENCER_DMA_CHANNEL, ENABLE);
+  DMA_GlobalCmd(ENABLE);
+  TIM1_DMAConfig(TIM1_DMABase_CCR1H, (TIM1_DMABurstLength_TypeDef)(burst - 1));
+  TIM1_DMACmd(TIM1_DMASource_Update, ENABLE);
+}
+
+void PWM_Sequencer_Stop(void)
+{
+  TIM1_DMACmd(TIM1_DMASource_Update, DISABLE);
+  PWM_SEQUENCER_DMA_CHANNEL->CCR &= (uint8_t)~DMA_CCR_CE;
+}
+
+#else
+
+static const uint8_t* SequenceTable;
+static const uint8_t* SequenceEnd;
+static const uint8_t* SequenceNext;
+static uint8_t SequenceBytes;
+
+void PWM_Sequencer_Start(const uint16_t* Table, uint8_t Steps, uint8_t Channels)
+{
+  PWM_Sequencer_Stop();
+  //Big-endian values: high byte first, in the order of the registers
+  SequenceTable = (const uint8_t*)Table;
+  SequenceBytes = (uint8_t)(Channels * 2);
+  SequenceEnd = SequenceTable + (uint8_t)(Steps * SequenceBytes);
+  SequenceNext = SequenceTable;
+  TIM1->SR1 = (uint8_t)~TIM1_SR1_UIF;
+  TIM1->IER |= TIM1_IER_UIE;
+}
+
+void PWM_Sequencer_Stop(void)
+{
+  TIM1->IER &= (uint8_t)~TIM1_IER_UIE;
+}
+
+PWM_SEQUENCER_IRQHandler()
+{
+  const uint8_t* next = SequenceNext;
+  volatile uint8_t* ccr = &TIM1->CCR1H;
+  uint8_t count = SequenceBytes;
+
+  TIM1->SR1 = (uint8_t)~TIM1_SR1_UIF;
+  do
+  {
+    *ccr++ = *next++;
+  } while (--count);
+  SequenceNext = next == SequenceEnd ? SequenceTable : next;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef STM8_PWM_SEQUENCER_H_
+#define STM8_PWM_SEQUENCER_H_
+
+/*
+ * TIM1 PWM waveform sequencer
+ *
+ * Plays a table of compare values in a loop: at each update event the
+ * compare registers of channels 1 to Channels take the next step of the
+ * table, Channels values per step (channel 1 first). The values are written
+ * to the preload registers and apply from the next period.
+ *
+ * Configure TIM1 with the StdPeriph driver (TIM1_TimeBaseInit, TIM1_OCxInit in
+ * PWM mode, TIM1_OCxPreloadConfig, TIM1_CtrlPWMOutputs, TIM1_Cmd), enable the
+ * clock of TIM1 on STM8L15x, then call PWM_Sequencer_Start().
+ *
+ * On STM8L15x DMA1 channel 3 writes each step with a TIM1 DMA burst on the
+ * update event, without interrupts (the table must be in RAM, channel 3 is
+ * also used by the AES). On STM8S the update interrupt copies the step:
+ * include this header in the file with main() so SDCC generates the vector.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#include "stm8_it.h"
+#define PWM_SEQUENCER_IRQHandler TIM1_UPD_OVF_TRG_BRK_IRQHandler
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#if defined(STM8L15X_LD) || defined(STM8L05X_LD_VL)
+#error "TIM1 is not available on STM8L15x low density devices"
+#endif
+#elif defined(STM8_FAMILY_L10X)
+#error "TIM1 is not available on STM8L10x"
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+
+/* Table holds Steps * Channels compare values, Channels 1 to 4 and up to 127
+   values (one DMA run) */
+void PWM_Sequencer_Start(const uint16_t* Table, uint8_t Steps, uint8_t Channels);
+//The compare registers keep the last step
+void PWM_Sequencer_Stop(void);
+
+#if defined(STM8_FAMILY_S)
+PWM_SEQUENCER_IRQHandler();
+#endif
+
+#endif //STM8_PWM_SEQUENCER_H_
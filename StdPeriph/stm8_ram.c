@@ -0,0 +1,31 @@
+#include "stm8_ram.h"
+
+#ifndef RAM_SEG_LOAD
+#error "RAM_SEG_LOAD is not defined, add stm8_ram.c with STM8_ADD_RAM_SEGMENT"
+#endif
+
+/* s_RAM_SEG and l_RAM_SEG are defined by the linker, copy backwards from the
+   last byte of the segment */
+void RAM_SEG_Load(void)
+{
+    __asm
+    ldw     x, #l_RAM_SEG
+    jreq    00002$
+00001$:
+    decw    x
+    ld      a, (RAM_SEG_LOAD, x)
+    ld      (s_RAM_SEG, x), a
+    tnzw    x
+    jrne    00001$
+00002$:
+    __endasm;
+}
+
+#ifdef RAM_SEG_STARTUP
+unsigned char __sdcc_external_startup(void)
+{
+    RAM_SEG_Load();
+    /* 0: continue with the initialization of global variables */
+    return 0;
+}
+#endif //RAM_SEG_STARTUP
@@ -0,0 +1,17 @@
+#ifndef STM8_RAM_H_
+#define STM8_RAM_H_
+
+/*
+ * RAM_SEG code segment loader (SDCC)
+ *
+ * Functions compiled with "--codeseg RAM_SEG" are linked at their RAM address,
+ * their image is stored in Flash at RAM_SEG_LOAD (see STM8_ADD_RAM_SEGMENT and
+ * STM8_SET_RAM_SEGMENT_PROPERTIES in sdcc-stm8.cmake).
+ *
+ * With RAM_SEG_STARTUP defined the segment is loaded by __sdcc_external_startup()
+ * before main(). RAM_SEG_Load() reloads it if its RAM area has been overwritten.
+ */
+
+void RAM_SEG_Load(void);
+
+#endif //STM8_RAM_H_
@@ -0,0 +1,98 @@
+#include "stm8_rtc_time.h"
+
+/* LSE / 32 = 1024 Hz calendar clock, SSR counts down from 1023 each second.
+   The wakeup timer runs at LSE / 16, 2 cycles per unit */
+#define RTC_TIME_ASYNCH_PREDIV 31
+#define RTC_TIME_SYNCH_PREDIV  1023
+
+#define RTC_TIME_BCD(VALUE) ((uint8_t)(((VALUE) >> 4) * 10 + ((VALUE) & 0x0F)))
+
+static uint16_t Days;
+static uint32_t LastSeconds;
+static volatile uint8_t WokenUp;
+
+ErrorStatus RTC_Time_Init(void)
+{
+  RTC_InitTypeDef init;
+
+  Days = 0;
+  LastSeconds = 0;
+
+  init.RTC_HourFormat = RTC_HourFormat_24;
+  init.RTC_AsynchPrediv = RTC_TIME_ASYNCH_PREDIV;
+  init.RTC_SynchPrediv = RTC_TIME_SYNCH_PREDIV;
+  if (RTC_Init(&init) == ERROR)
+  {
+    return ERROR;
+  }
+  RTC_BypassShadowCmd(ENABLE);
+  RTC_WakeUpCmd(DISABLE);
+  RTC_WakeUpClockConfig(RTC_WakeUpClock_RTCCLK_Div16);
+  RTC_ITConfig(RTC_IT_WUT, ENABLE);
+  return SUCCESS;
+}
+
+/* The counters are read directly: read again until a carry didn't happen in
+   between. The day count follows the time of day going backwards. */
+uint32_t RTC_Time_Now(void)
+{
+  uint8_t ssh, ssl, sec, min, hour;
+  uint32_t seconds;
+
+  do
+  {
+    ssh = RTC->SSRH;
+    ssl = RTC->SSRL;
+    sec = RTC->TR1;
+    min = RTC->TR2;
+    hour = RTC->TR3;
+  } while (ssl != RTC->SSRL || ssh != RTC->SSRH || sec != RTC->TR1);
+
+  seconds = (uint32_t)RTC_TIME_BCD(hour & 0x3F) * 3600 + (uint16_t)RTC_TIME_BCD(min & 0x7F) * 60 +
+            RTC_TIME_BCD(sec & 0x7F);
+  if (seconds < LastSeconds)
+  {
+    Days++;
+  }
+  LastSeconds = seconds;
+  seconds += (uint32_t)Days * 86400;
+
+  return (seconds << 10) + (uint16_t)(RTC_TIME_SYNCH_PREDIV - (((uint16_t)ssh << 8) | ssl));
+}
+
+uint8_t RTC_Time_SleepUntil(uint32_t Deadline)
+{
+  int32_t remaining;
+
+  for (;;)
+  {
+    remaining = (int32_t)(Deadline - RTC_Time_Now());
+    if (remaining <= 0)
+    {
+      return 1;
+    }
+    if (remaining > RTC_TIME_MAX_SLEEP)
+    {
+      remaining = RTC_TIME_MAX_SLEEP;
+    }
+
+    //halt enables interrupts: the wakeup can't happen before it
+    disableInterrupts();
+    RTC_WakeUpCmd(DISABLE);
+    RTC_SetWakeUpCounter((uint16_t)(((uint16_t)remaining << 1) - 1));
+    RTC_WakeUpCmd(ENABLE);
+    WokenUp = 0;
+    halt();
+    RTC_WakeUpCmd(DISABLE);
+    if (!WokenUp)
+    {
+      return 0;
+    }
+  }
+}
+
+RTC_IRQHandler()
+{
+  RTC_ClearITPendingBit(RTC_IT_WUT);
+  WokenUp = 1;
+}
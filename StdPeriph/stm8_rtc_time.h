@@ -0,0 +1,44 @@
+#ifndef STM8_RTC_TIME_H_
+#define STM8_RTC_TIME_H_
+
+/*
+ * Tickless timebase on the RTC of STM8L15x
+ *
+ * RTC_Time_Now() is a monotonic 32-bit count of 1/1024 s (RTC_TIME_FREQUENCY),
+ * read from the RTC subsecond and time registers directly (shadow registers
+ * bypassed, no RTC_GetTime() structure and no wait for synchronization after
+ * halt). It wraps after 48 days. RTC_Time_SleepUntil() programs the wakeup
+ * timer for the deadline and stays in active-halt until then: there is no
+ * periodic tick.
+ *
+ * Select the 32.768 kHz LSE as RTC clock (CLK_RTCClockConfig(), RTCCLK
+ * divider 1) and enable the RTC peripheral clock before RTC_Time_Init(). The
+ * RTC prescalers are set for 1024 Hz, the calendar counts the elapsed time:
+ * call RTC_Time_Now() at least once a day (sleeps are at most 32 s).
+ * Include this header in the file with main() so SDCC generates the vector.
+ */
+
+#if !defined(STM8_FAMILY_L15X)
+#error "STM8_FAMILY_L15X is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+#include <stm8l15x.h>
+#include <stm8l15x_rtc.h>
+#include "stm8_it.h"
+
+#define RTC_TIME_FREQUENCY 1024
+
+//Milliseconds to RTC_Time_Now() units, rounded down
+#define RTC_TIME_MS(MS) ((uint32_t)((uint32_t)(MS) * RTC_TIME_FREQUENCY / 1000))
+
+//Longest single wakeup timer period, RTC_Time_SleepUntil() sleeps again after it
+#define RTC_TIME_MAX_SLEEP ((int32_t)32768)
+
+//Returns ERROR when the RTC doesn't enter its initialization mode (RTC clock not running)
+ErrorStatus RTC_Time_Init(void);
+uint32_t RTC_Time_Now(void);
+//Returns 1 at Deadline, 0 when another interrupt woke the CPU up before
+uint8_t RTC_Time_SleepUntil(uint32_t Deadline);
+
+RTC_IRQHandler();
+
+#endif //STM8_RTC_TIME_H_
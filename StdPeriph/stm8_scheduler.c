@@ -0,0 +1,158 @@
+#include "stm8_scheduler.h"
+
+#if SCHEDULER_TASKS < 1 || SCHEDULER_TASKS > 8
+#error "SCHEDULER_TASKS must be 1 to 8"
+#endif
+
+#if defined(STM8_FAMILY_S)
+#define SCHEDULER_TIM4_IT TIM4_IT_UPDATE
+#else
+#define SCHEDULER_TIM4_IT TIM4_IT_Update
+#endif
+
+static Scheduler_Task_TypeDef Tasks[SCHEDULER_TASKS];
+static uint8_t TaskCount;
+static uint8_t Halt;
+/* One bit per task: ready tasks, running delays. Updated with interrupts
+   masked, handlers of a higher priority may post meanwhile */
+static volatile uint8_t Pending;
+static volatile uint8_t Timers;
+static uint16_t Delays[SCHEDULER_TASKS];
+static volatile uint16_t Ticks;
+
+void Scheduler_Init(TIM4_Prescaler_TypeDef Prescaler, uint8_t Period)
+{
+  TaskCount = 0;
+  Halt = 0;
+  Pending = 0;
+  Timers = 0;
+  Ticks = 0;
+
+  TIM4_TimeBaseInit(Prescaler, Period);
+  TIM4->SR1 = (uint8_t)~TIM4_SR1_UIF;
+  TIM4_ITConfig(SCHEDULER_TIM4_IT, ENABLE);
+  TIM4_Cmd(ENABLE);
+}
+
+uint8_t Scheduler_Add(Scheduler_Task_TypeDef Task)
+{
+  if (TaskCount == SCHEDULER_TASKS)
+  {
+    return 0xFF;
+  }
+  Tasks[TaskCount] = Task;
+  return TaskCount++;
+}
+
+void Scheduler_Post(uint8_t Id)
+{
+  if (Id >= TaskCount)
+  {
+    return;
+  }
+  __critical
+  {
+    Pending |= (uint8_t)(1 << Id);
+  }
+}
+
+void Scheduler_Delay(uint8_t Id, uint16_t Ticks)
+{
+  uint8_t mask;
+
+  if (Id >= TaskCount)
+  {
+    return;
+  }
+  mask = (uint8_t)(1 << Id);
+  __critical
+  {
+    Delays[Id] = Ticks;
+    if (Ticks != 0)
+    {
+      Timers |= mask;
+    }
+    else
+    {
+      Timers &= (uint8_t)~mask;
+    }
+  }
+}
+
+void Scheduler_SetHalt(FunctionalState NewState)
+{
+  Halt = (uint8_t)(NewState != DISABLE);
+}
+
+uint16_t Scheduler_GetTicks(void)
+{
+  uint16_t ticks;
+
+  __critical
+  {
+    ticks = Ticks;
+  }
+  return ticks;
+}
+
+void Scheduler_Run(void)
+{
+  uint8_t pending;
+  uint8_t mask;
+  uint8_t i;
+
+  for (;;)
+  {
+    disableInterrupts();
+    pending = Pending;
+    if (pending == 0)
+    {
+      //wfi and halt enable interrupts, a post after the test wakes the CPU up
+      if (Halt && Timers == 0)
+      {
+        halt();
+      }
+      else
+      {
+        wfi();
+      }
+      continue;
+    }
+    for (i = 0, mask = 1; !(pending & mask); i++, mask <<= 1)
+    {
+    }
+    Pending = (uint8_t)(pending & (uint8_t)~mask);
+    enableInterrupts();
+    Tasks[i]();
+  }
+}
+
+SCHEDULER_IRQHandler()
+{
+  uint8_t timers = Timers;
+  uint8_t expired = 0;
+  uint8_t mask;
+  uint8_t i;
+
+  TIM4->SR1 = (uint8_t)~TIM4_SR1_UIF;
+  Ticks++;
+  for (i = 0, mask = 1; timers != 0; i++, mask <<= 1)
+  {
+    if (timers & mask)
+    {
+      timers &= (uint8_t)~mask;
+      if (--Delays[i] == 0)
+      {
+        expired |= mask;
+      }
+    }
+  }
+  if (expired != 0)
+  {
+    __critical
+    {
+      Timers &= (uint8_t)~expired;
+      Pending |= expired;
+    }
+  }
+}
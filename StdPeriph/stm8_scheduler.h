@@ -0,0 +1,65 @@
+#ifndef STM8_SCHEDULER_H_
+#define STM8_SCHEDULER_H_
+
+/*
+ * Cooperative run-to-completion task scheduler on TIM4
+ *
+ * Tasks are functions in a fixed table, run by Scheduler_Run() when their
+ * event is posted, by an interrupt handler or a task (Scheduler_Post()), or
+ * when their delay expires (Scheduler_Delay(), in TIM4 update periods). A
+ * task runs to completion, the lowest id first. When no task is ready the CPU
+ * waits in wfi, or in halt with Scheduler_SetHalt() when no delay is running
+ * (TIM4 stops in halt, an external interrupt wakes the CPU up).
+ *
+ * Configure the clock of TIM4 (CLK_PeripheralClockConfig() on STM8L), call
+ * Scheduler_Init() and Scheduler_Add() then Scheduler_Run(), which enables
+ * interrupts and doesn't return.
+ * Include this header in the file with main() so SDCC generates the vector.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#include <stm8s_tim4.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#include <stm8l15x_tim4.h>
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#include <stm8l10x_tim4.h>
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+#include "stm8_it.h"
+
+#if defined(STM8_FAMILY_L15X)
+#define SCHEDULER_IRQHandler TIM4_UPD_OVF_TRG_IRQHandler
+#elif defined(STM8S903)
+#error "TIM4 is not available on STM8S903"
+#else
+#define SCHEDULER_IRQHandler TIM4_UPD_OVF_IRQHandler
+#endif
+
+//Size of the task table, up to 8
+#ifndef SCHEDULER_TASKS
+#define SCHEDULER_TASKS 8
+#endif
+
+typedef void (*Scheduler_Task_TypeDef)(void);
+
+//TIM4 update period: (Period + 1) << Prescaler timer clock cycles
+void Scheduler_Init(TIM4_Prescaler_TypeDef Prescaler, uint8_t Period);
+//Returns the id of the task, 0xFF when the table is full (ignored by Post and Delay)
+uint8_t Scheduler_Add(Scheduler_Task_TypeDef Task);
+//Makes the task ready, from interrupt handlers as well
+void Scheduler_Post(uint8_t Id);
+//Posts the task after Ticks update periods, 0 cancels the delay
+void Scheduler_Delay(uint8_t Id, uint16_t Ticks);
+//Halt instead of wfi when no delay is running (peripherals stop, wake up on external interrupts)
+void Scheduler_SetHalt(FunctionalState NewState);
+//Update periods since Scheduler_Init(), wraps
+uint16_t Scheduler_GetTicks(void);
+void Scheduler_Run(void);
+
+SCHEDULER_IRQHandler();
+
+#endif //STM8_SCHEDULER_H_
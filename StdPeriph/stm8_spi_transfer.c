@@ -0,0 +1,253 @@
+#include "stm8_spi_transfer.h"
+
+#if defined(STM8_FAMILY_L15X)
+#include <stm8l15x_clk.h>
+#include <stm8l15x_dma.h>
+#include <stm8l15x_spi.h>
+
+#define SPI_TRANSFER_SPI    SPI1
+#define SPI_TRANSFER_DMA_RX DMA1_Channel1
+#define SPI_TRANSFER_DMA_TX DMA1_Channel2
+//Longest segment of one DMA run
+#define SPI_TRANSFER_SEGMENT 255
+
+static const uint8_t* TxNext;
+static uint8_t* RxNext;
+static uint16_t Remaining;
+static SPI_Transfer_Callback_TypeDef TransferCallback;
+//Channel ending the segments: RX, TX when the received bytes are discarded
+static DMA_Channel_TypeDef* Last;
+static volatile uint8_t Busy;
+
+void SPI_Transfer_Init(void)
+{
+  Busy = 0;
+
+  CLK_PeripheralClockConfig(CLK_Peripheral_DMA1, ENABLE);
+  DMA_Init(SPI_TRANSFER_DMA_RX, 0, (uint16_t)&SPI_TRANSFER_SPI->DR, 1, DMA_DIR_PeripheralToMemory,
+           DMA_Mode_Normal, DMA_MemoryIncMode_Inc, DMA_Priority_VeryHigh, DMA_MemoryDataSize_Byte);
+  DMA_Init(SPI_TRANSFER_DMA_TX, 0, (uint16_t)&SPI_TRANSFER_SPI->DR, 1, DMA_DIR_MemoryToPeripheral,
+           DMA_Mode_Normal, DMA_MemoryIncMode_Inc, DMA_Priority_High, DMA_MemoryDataSize_Byte);
+  DMA_GlobalCmd(ENABLE);
+}
+
+/* The RX channel is enabled first: the TX channel starts at once (TXE is set)
+   and every byte it sends is received */
+static void SPI_Transfer_Segment(void)
+{
+  uint8_t count = Remaining > SPI_TRANSFER_SEGMENT ? SPI_TRANSFER_SEGMENT : (uint8_t)Remaining;
+
+  if (RxNext)
+  {
+    SPI_TRANSFER_DMA_RX->CM0ARH = (uint8_t)((uint16_t)RxNext >> 8);
+    SPI_TRANSFER_DMA_RX->CM0ARL = (uint8_t)(uint16_t)RxNext;
+    DMA_SetCurrDataCounter(SPI_TRANSFER_DMA_RX, count);
+    SPI_TRANSFER_DMA_RX->CCR |= DMA_CCR_CE;
+    RxNext += count;
+  }
+  SPI_TRANSFER_DMA_TX->CM0ARH = (uint8_t)((uint16_t)TxNext >> 8);
+  SPI_TRANSFER_DMA_TX->CM0ARL = (uint8_t)(uint16_t)TxNext;
+  DMA_SetCurrDataCounter(SPI_TRANSFER_DMA_TX, count);
+  SPI_TRANSFER_DMA_TX->CCR |= DMA_CCR_CE;
+  TxNext += count;
+  Remaining -= count;
+}
+
+uint8_t SPI_Transfer_Start(const uint8_t* Tx, uint8_t* Rx, uint16_t Length, SPI_Transfer_Callback_TypeDef Callback)
+{
+  if (Busy)
+  {
+    return 0;
+  }
+  if (Length == 0)
+  {
+    if (Callback)
+    {
+      Callback();
+    }
+    return 1;
+  }
+  Busy = 1;
+  TxNext = Tx ? Tx : Rx;
+  RxNext = Rx;
+  Remaining = Length;
+  TransferCallback = Callback;
+  Last = Rx ? SPI_TRANSFER_DMA_RX : SPI_TRANSFER_DMA_TX;
+
+  //Clears RXNE and OVR left by a transfer without Rx
+  (void)SPI_TRANSFER_SPI->DR;
+  (void)SPI_TRANSFER_SPI->SR;
+  SPI_TRANSFER_SPI->CR3 |= (uint8_t)(Rx ? (SPI_DMAReq_RX | SPI_DMAReq_TX) : SPI_DMAReq_TX);
+  Last->CCR |= DMA_CCR_TCIE;
+  SPI_Transfer_Segment();
+  return 1;
+}
+
+uint8_t SPI_Transfer_IsBusy(void)
+{
+  return Busy;
+}
+
+void SPI_Transfer(const uint8_t* Tx, uint8_t* Rx, uint16_t Length)
+{
+  while (!SPI_Transfer_Start(Tx, Rx, Length, 0))
+  {
+  }
+  while (Busy)
+  {
+  }
+}
+
+void SPI_Transfer_DMA_IRQHandler(void)
+{
+  if (!Busy || !(Last->CSPR & DMA_CSPR_TCIF))
+  {
+    return;
+  }
+  SPI_TRANSFER_DMA_RX->CCR &= (uint8_t)~DMA_CCR_CE;
+  SPI_TRANSFER_DMA_TX->CCR &= (uint8_t)~DMA_CCR_CE;
+  SPI_TRANSFER_DMA_RX->CSPR &= (uint8_t)~DMA_CSPR_TCIF;
+  SPI_TRANSFER_DMA_TX->CSPR &= (uint8_t)~DMA_CSPR_TCIF;
+  if (Remaining != 0)
+  {
+    SPI_Transfer_Segment();
+    return;
+  }
+
+  Last->CCR &= (uint8_t)~DMA_CCR_TCIE;
+  SPI_TRANSFER_SPI->CR3 &= (uint8_t)~(SPI_DMAReq_RX | SPI_DMAReq_TX);
+  //Without Rx the last byte is still being shifted out
+  while (SPI_TRANSFER_SPI->SR & SPI_SR_BSY)
+  {
+  }
+  Busy = 0;
+  if (TransferCallback)
+  {
+    TransferCallback();
+  }
+}
+
+#else
+
+/* SPI registers for the assembly loops, at the same address on STM8S and
+   STM8L10x */
+#define SPI_TRANSFER_SR 0x5203
+#define SPI_TRANSFER_DR 0x5204
+
+/* Arguments of the loops: SDCC inline assembly can't refer to parameters or
+   locals, and the stack layout depends on the calling convention */
+static const uint8_t* TxPointer;
+static uint8_t* RxPointer;
+static uint16_t End;
+
+/* Every loop writes the next byte as soon as TXE is set, while the shift
+   register sends the previous one. At SPI_BaudRatePrescaler_2 a byte takes 16
+   CPU cycles, the longest (full-duplex) loop takes 15. */
+
+//Sends TxPointer up to End, then waits for the last byte and clears RXNE and OVR
+static void SPI_Transfer_Write(void)
+{
+  __asm
+    ldw     x, _TxPointer
+00001$:
+    btjf    SPI_TRANSFER_SR, #1, 00001$
+    ld      a, (x)
+    ld      SPI_TRANSFER_DR, a
+    incw    x
+    cpw     x, _End
+    jrne    00001$
+00002$:
+    btjf    SPI_TRANSFER_SR, #1, 00002$
+00003$:
+    btjt    SPI_TRANSFER_SR, #7, 00003$
+    ld      a, SPI_TRANSFER_DR
+    ld      a, SPI_TRANSFER_SR
+  __endasm;
+}
+
+//Sends 0xFF and receives into RxPointer up to End, the last byte
+static void SPI_Transfer_Read(void)
+{
+  __asm
+    ldw     x, _RxPointer
+    mov     SPI_TRANSFER_DR, #0xFF
+    cpw     x, _End
+    jreq    00003$
+00001$:
+    btjf    SPI_TRANSFER_SR, #1, 00001$
+    mov     SPI_TRANSFER_DR, #0xFF
+00002$:
+    btjf    SPI_TRANSFER_SR, #0, 00002$
+    ld      a, SPI_TRANSFER_DR
+    ld      (x), a
+    incw    x
+    cpw     x, _End
+    jrne    00001$
+00003$:
+    btjf    SPI_TRANSFER_SR, #0, 00003$
+    ld      a, SPI_TRANSFER_DR
+    ld      (x), a
+  __endasm;
+}
+
+//Sends TxPointer up to End and receives into RxPointer
+static void SPI_Transfer_Exchange(void)
+{
+  __asm
+    ldw     x, _TxPointer
+    ldw     y, _RxPointer
+    ld      a, (x)
+    ld      SPI_TRANSFER_DR, a
+    incw    x
+    cpw     x, _End
+    jreq    00003$
+00001$:
+    btjf    SPI_TRANSFER_SR, #1, 00001$
+    ld      a, (x)
+    ld      SPI_TRANSFER_DR, a
+    incw    x
+00002$:
+    btjf    SPI_TRANSFER_SR, #0, 00002$
+    ld      a, SPI_TRANSFER_DR
+    ld      (y), a
+    incw    y
+    cpw     x, _End
+    jrne    00001$
+00003$:
+    btjf    SPI_TRANSFER_SR, #0, 00003$
+    ld      a, SPI_TRANSFER_DR
+    ld      (y), a
+  __endasm;
+}
+
+void SPI_Transfer(const uint8_t* Tx, uint8_t* Rx, uint16_t Length)
+{
+  if (Length == 0 || (!Tx && !Rx))
+  {
+    return;
+  }
+  //Received byte or overrun left by a previous transfer
+  (void)SPI->DR;
+  (void)SPI->SR;
+
+  TxPointer = Tx;
+  RxPointer = Rx;
+  if (!Rx)
+  {
+    End = (uint16_t)(Tx + Length);
+    SPI_Transfer_Write();
+  }
+  else if (!Tx)
+  {
+    //The loop stops at the last byte
+    End = (uint16_t)(Rx + Length - 1);
+    SPI_Transfer_Read();
+  }
+  else
+  {
+    End = (uint16_t)(Tx + Length);
+    SPI_Transfer_Exchange();
+  }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef STM8_SPI_TRANSFER_H_
+#define STM8_SPI_TRANSFER_H_
+
+/*
+ * SPI buffer transfers: SPI on STM8S and STM8L10x, SPI1 on STM8L15x
+ *
+ * Configure the SPI as master with the StdPeriph driver (SPI_Init, SPI_Cmd).
+ * SPI_Transfer() sends Length bytes from Tx while it receives Length bytes
+ * into Rx. Tx 0 sends 0xFF, Rx 0 discards the received bytes.
+ *
+ * On STM8L15x the transfers run on DMA1 channels 1 (RX) and 2 (TX), in
+ * segments of up to 255 bytes (8-bit DMA counters) chained by the transfer
+ * complete interrupt. SPI_Transfer_Start() returns at once and the callback
+ * is called (in interrupt context) at the end. Call SPI_Transfer_DMA_IRQHandler()
+ * from DMA1_CHANNEL0_1_IRQHandler() and DMA1_CHANNEL2_3_IRQHandler(). Channel 1
+ * is also the USART_BUFFER_DMA channel. With Tx 0 the DMA sends the previous
+ * content of Rx (the data sent doesn't matter when reading).
+ *
+ * On STM8S and STM8L10x (no DMA) SPI_Transfer() polls the SPI in assembly
+ * loops (write, read, full-duplex) that keep the next byte in the TX buffer
+ * while the shift register runs, fast enough for SPI_BaudRatePrescaler_2.
+ * Received bytes are lost when an interrupt holds the loop for more than a
+ * byte time: mask interrupts around reads at high baud rates.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+
+#if defined(STM8_FAMILY_L15X)
+typedef void (*SPI_Transfer_Callback_TypeDef)(void);
+
+void SPI_Transfer_Init(void);
+//Returns 0 when a transfer is already running
+uint8_t SPI_Transfer_Start(const uint8_t* Tx, uint8_t* Rx, uint16_t Length, SPI_Transfer_Callback_TypeDef Callback);
+uint8_t SPI_Transfer_IsBusy(void);
+
+void SPI_Transfer_DMA_IRQHandler(void);
+#endif
+
+//Blocks until the last byte is received, interrupts enabled on STM8L15x
+void SPI_Transfer(const uint8_t* Tx, uint8_t* Rx, uint16_t Length);
+
+#endif //STM8_SPI_TRANSFER_H_
@@ -0,0 +1,230 @@
+#include "stm8_usart_buffer.h"
+
+#if defined(STM8_FAMILY_S) && (defined(STM8S105) || defined(STM8S005))
+#define USART_BUFFER_PORT     UART2
+#define USART_BUFFER_SR_OR    UART2_SR_OR
+#define USART_BUFFER_CR2_RIEN UART2_CR2_RIEN
+#define USART_BUFFER_CR2_TIEN UART2_CR2_TIEN
+#elif defined(STM8_FAMILY_S)
+#define USART_BUFFER_PORT     UART1
+#define USART_BUFFER_SR_OR    UART1_SR_OR
+#define USART_BUFFER_CR2_RIEN UART1_CR2_RIEN
+#define USART_BUFFER_CR2_TIEN UART1_CR2_TIEN
+#else
+#if defined(STM8_FAMILY_L15X)
+#define USART_BUFFER_PORT     USART1
+#else
+#define USART_BUFFER_PORT     USART
+#endif
+#define USART_BUFFER_SR_OR    USART_SR_OR
+#define USART_BUFFER_CR2_RIEN USART_CR2_RIEN
+#define USART_BUFFER_CR2_TIEN USART_CR2_TIEN
+#endif
+
+#if defined(USART_BUFFER_DMA)
+#include <stm8l15x_clk.h>
+#include <stm8l15x_dma.h>
+#include <stm8l15x_usart.h>
+#define USART_BUFFER_DMA_CHANNEL DMA1_Channel1
+#endif
+
+#if (USART_BUFFER_RX_SIZE & (USART_BUFFER_RX_SIZE - 1)) || USART_BUFFER_RX_SIZE > 128
+#error "USART_BUFFER_RX_SIZE must be a power of 2 up to 128"
+#endif
+#if (USART_BUFFER_TX_SIZE & (USART_BUFFER_TX_SIZE - 1)) || USART_BUFFER_TX_SIZE > 128
+#error "USART_BUFFER_TX_SIZE must be a power of 2 up to 128"
+#endif
+
+/* Free running indices, the buffer position is the index modulo the size and
+   the fill level their difference. Head is written by the producer only, tail
+   by the consumer only. */
+static uint8_t RxBuffer[USART_BUFFER_RX_SIZE];
+static volatile uint8_t RxHead;
+static volatile uint8_t RxTail;
+static uint8_t TxBuffer[USART_BUFFER_TX_SIZE];
+static volatile uint8_t TxHead;
+static volatile uint8_t TxTail;
+#if defined(USART_BUFFER_DMA)
+/* Bytes of the running DMA transfer, 0 when idle */
+static volatile uint8_t TxDMACount;
+#endif
+
+static volatile USART_Buffer_Stats_TypeDef BufferStats;
+
+#if defined(USART_BUFFER_DMA)
+/* Starts the transfer of the bytes from the tail up to the head or to the end
+   of the buffer. Called with the transfer complete interrupt masked. */
+static void USART_Buffer_StartDMA(void)
+{
+  uint8_t index = (uint8_t)(TxTail & (USART_BUFFER_TX_SIZE - 1));
+  uint8_t count = (uint8_t)(TxHead - TxTail);
+  uint16_t address = (uint16_t)&TxBuffer[index];
+
+  if (count == 0)
+  {
+    return;
+  }
+  if (count > (uint8_t)(USART_BUFFER_TX_SIZE - index))
+  {
+    count = (uint8_t)(USART_BUFFER_TX_SIZE - index);
+  }
+  TxDMACount = count;
+  USART_BUFFER_DMA_CHANNEL->CM0ARH = (uint8_t)(address >> 8);
+  USART_BUFFER_DMA_CHANNEL->CM0ARL = (uint8_t)address;
+  USART_BUFFER_DMA_CHANNEL->CNBTR = count;
+  USART_BUFFER_DMA_CHANNEL->CCR |= DMA_CCR_CE;
+}
+#endif
+
+void USART_Buffer_Init(void)
+{
+  RxHead = RxTail = 0;
+  TxHead = TxTail = 0;
+  USART_Buffer_ResetStats();
+
+#if defined(USART_BUFFER_DMA)
+  TxDMACount = 0;
+  CLK_PeripheralClockConfig(CLK_Peripheral_DMA1, ENABLE);
+  DMA_Init(USART_BUFFER_DMA_CHANNEL, (uint32_t)(uint16_t)TxBuffer, (uint16_t)&USART1->DR, 1,
+           DMA_DIR_MemoryToPeripheral, DMA_Mode_Normal, DMA_MemoryIncMode_Inc,
+           DMA_Priority_High, DMA_MemoryDataSize_Byte);
+  DMA_ITConfig(USART_BUFFER_DMA_CHANNEL, DMA_ITx_TC, ENABLE);
+  DMA_GlobalCmd(ENABLE);
+  USART_DMACmd(USART1, USART_DMAReq_TX, ENABLE);
+#endif
+
+  USART_BUFFER_PORT->CR2 |= USART_BUFFER_CR2_RIEN;
+}
+
+uint8_t USART_Buffer_Write(const uint8_t* Data, uint8_t Length)
+{
+  uint8_t head = TxHead;
+  uint8_t count;
+  uint8_t written = 0;
+
+  while (written < Length && (uint8_t)(head - TxTail) < USART_BUFFER_TX_SIZE)
+  {
+    TxBuffer[head & (USART_BUFFER_TX_SIZE - 1)] = Data[written++];
+    head++;
+  }
+  TxHead = head;
+
+  count = (uint8_t)(head - TxTail);
+  if (count > BufferStats.TxMaxCount)
+  {
+    BufferStats.TxMaxCount = count;
+  }
+
+#if defined(USART_BUFFER_DMA)
+  /* The transfer complete interrupt starts the next transfer, only start one
+     here when the channel is idle */
+  USART_BUFFER_DMA_CHANNEL->CCR &= (uint8_t)~DMA_CCR_TCIE;
+  if (TxDMACount == 0)
+  {
+    USART_Buffer_StartDMA();
+  }
+  USART_BUFFER_DMA_CHANNEL->CCR |= DMA_CCR_TCIE;
+#else
+  USART_BUFFER_PORT->CR2 |= USART_BUFFER_CR2_TIEN;
+#endif
+  return written;
+}
+
+uint8_t USART_Buffer_Read(uint8_t* Data, uint8_t Length)
+{
+  uint8_t tail = RxTail;
+  uint8_t read = 0;
+
+  while (read < Length && tail != RxHead)
+  {
+    Data[read++] = RxBuffer[tail & (USART_BUFFER_RX_SIZE - 1)];
+    tail++;
+  }
+  RxTail = tail;
+  return read;
+}
+
+uint8_t USART_Buffer_GetRxCount(void)
+{
+  return (uint8_t)(RxHead - RxTail);
+}
+
+uint8_t USART_Buffer_GetTxFree(void)
+{
+  return (uint8_t)(USART_BUFFER_TX_SIZE - (uint8_t)(TxHead - TxTail));
+}
+
+/* The 16-bit counters are read again until unchanged by the RX interrupt */
+void USART_Buffer_GetStats(USART_Buffer_Stats_TypeDef* Stats)
+{
+  do
+  {
+    Stats->RxOverrun = BufferStats.RxOverrun;
+    Stats->RxDropped = BufferStats.RxDropped;
+  } while (Stats->RxOverrun != BufferStats.RxOverrun || Stats->RxDropped != BufferStats.RxDropped);
+  Stats->RxMaxCount = BufferStats.RxMaxCount;
+  Stats->TxMaxCount = BufferStats.TxMaxCount;
+}
+
+void USART_Buffer_ResetStats(void)
+{
+  BufferStats.RxOverrun = 0;
+  BufferStats.RxDropped = 0;
+  BufferStats.RxMaxCount = 0;
+  BufferStats.TxMaxCount = 0;
+}
+
+/* Reading SR then DR clears RXNE and the overrun flag */
+USART_BUFFER_RX_IRQHandler()
+{
+  uint8_t status = USART_BUFFER_PORT->SR;
+  uint8_t data = USART_BUFFER_PORT->DR;
+  uint8_t count = (uint8_t)(RxHead - RxTail);
+
+  if (status & USART_BUFFER_SR_OR)
+  {
+    BufferStats.RxOverrun++;
+  }
+  if (count == USART_BUFFER_RX_SIZE)
+  {
+    BufferStats.RxDropped++;
+    return;
+  }
+  RxBuffer[RxHead & (USART_BUFFER_RX_SIZE - 1)] = data;
+  RxHead++;
+  count++;
+  if (count > BufferStats.RxMaxCount)
+  {
+    BufferStats.RxMaxCount = count;
+  }
+}
+
+#if defined(USART_BUFFER_DMA)
+void USART_Buffer_DMA_IRQHandler(void)
+{
+  if (USART_BUFFER_DMA_CHANNEL->CSPR & DMA_CSPR_TCIF)
+  {
+    USART_BUFFER_DMA_CHANNEL->CSPR &= (uint8_t)~DMA_CSPR_TCIF;
+    USART_BUFFER_DMA_CHANNEL->CCR &= (uint8_t)~DMA_CCR_CE;
+    TxTail = (uint8_t)(TxTail + TxDMACount);
+    TxDMACount = 0;
+    USART_Buffer_StartDMA();
+  }
+}
+#else
+/* TXE: next byte, or no more TX interrupts until USART_Buffer_Write() */
+USART_BUFFER_TX_IRQHandler()
+{
+  uint8_t tail = TxTail;
+
+  if (tail != TxHead)
+  {
+    USART_BUFFER_PORT->DR = TxBuffer[tail & (USART_BUFFER_TX_SIZE - 1)];
+    TxTail = (uint8_t)(tail + 1);
+  }
+  else
+  {
+    USART_BUFFER_PORT->CR2 &= (uint8_t)~USART_BUFFER_CR2_TIEN;
+  }
+}
+#endif
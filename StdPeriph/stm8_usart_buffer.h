@@ -0,0 +1,83 @@
+#ifndef STM8_USART_BUFFER_H_
+#define STM8_USART_BUFFER_H_
+
+/*
+ * Interrupt driven, ring buffered USART: UART1 (UART2 on STM8S105/005) on
+ * STM8S, USART on STM8L10x, USART1 on STM8L15x
+ *
+ * Configure the USART with the StdPeriph driver (UARTx_Init, USART_Init...),
+ * call USART_Buffer_Init() and enable interrupts. The RX interrupt stores the
+ * received bytes, bytes queued by USART_Buffer_Write() are sent by the TX
+ * interrupt or, on STM8L15x with USART_BUFFER_DMA defined, by DMA1 channel 1
+ * in blocks of contiguous bytes. DMA1 channels 0 and 1 share their vector, call
+ * USART_Buffer_DMA_IRQHandler() from DMA1_CHANNEL0_1_IRQHandler().
+ *
+ * Each buffer has a single producer and a single consumer (the main program on
+ * one side, the interrupt on the other) and 8-bit indices, nothing is masked.
+ * Include this header in the file with main() so SDCC generates the vectors.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+#include "stm8_it.h"
+
+//Buffer sizes in bytes, powers of 2 up to 128
+#ifndef USART_BUFFER_RX_SIZE
+#define USART_BUFFER_RX_SIZE 32
+#endif
+#ifndef USART_BUFFER_TX_SIZE
+#define USART_BUFFER_TX_SIZE 32
+#endif
+
+#if defined(STM8_FAMILY_S) && (defined(STM8S105) || defined(STM8S005))
+#define USART_BUFFER_RX_IRQHandler UART2_RX_IRQHandler
+#define USART_BUFFER_TX_IRQHandler UART2_TX_IRQHandler
+#elif defined(STM8_FAMILY_S)
+#define USART_BUFFER_RX_IRQHandler UART1_RX_IRQHandler
+#define USART_BUFFER_TX_IRQHandler UART1_TX_IRQHandler
+#elif defined(STM8_FAMILY_L15X)
+#define USART_BUFFER_RX_IRQHandler USART1_RX_IRQHandler
+#define USART_BUFFER_TX_IRQHandler USART1_TX_IRQHandler
+#else
+#define USART_BUFFER_RX_IRQHandler USART_RX_IRQHandler
+#define USART_BUFFER_TX_IRQHandler USART_TX_IRQHandler
+#endif
+
+#if defined(USART_BUFFER_DMA) && !defined(STM8_FAMILY_L15X)
+#error "USART_BUFFER_DMA is only available on STM8L15x"
+#endif
+
+//Counters to size the buffers, see USART_Buffer_GetStats()
+typedef struct
+{
+  uint16_t RxOverrun;   /* Bytes lost by the USART (overrun), interrupt latency too high */
+  uint16_t RxDropped;   /* Bytes received while the RX buffer was full */
+  uint8_t RxMaxCount;   /* Highest RX buffer fill level */
+  uint8_t TxMaxCount;   /* Highest TX buffer fill level */
+} USART_Buffer_Stats_TypeDef;
+
+void USART_Buffer_Init(void);
+//Queues up to Length bytes, returns the number of bytes queued
+uint8_t USART_Buffer_Write(const uint8_t* Data, uint8_t Length);
+//Reads up to Length received bytes, returns the number of bytes read
+uint8_t USART_Buffer_Read(uint8_t* Data, uint8_t Length);
+uint8_t USART_Buffer_GetRxCount(void);
+uint8_t USART_Buffer_GetTxFree(void);
+void USART_Buffer_GetStats(USART_Buffer_Stats_TypeDef* Stats);
+void USART_Buffer_ResetStats(void);
+
+USART_BUFFER_RX_IRQHandler();
+#if defined(USART_BUFFER_DMA)
+void USART_Buffer_DMA_IRQHandler(void);
+#else
+USART_BUFFER_TX_IRQHandler();
+#endif
+
+#endif //STM8_USART_BUFFER_H_
@@ -1,7 +1,16 @@
 #ifndef STM8L15X_CONF_H_
 #define STM8L15X_CONF_H_
 
-#ifdef  USE_FULL_ASSERT
+#if defined(USE_COMPACT_ASSERT)
+
+/* Component id (see STM8_StdPeriph_ASSERT_IDS in FindSTM8_StdPeriph.cmake) and
+   line, no file name string: recorded by stm8_assert.c */
+#ifndef ASSERT_MODULE_ID
+#define ASSERT_MODULE_ID 0
+#endif
+#define assert_param(expr) ((expr) ? (void)0 : assert_compact_failed(ASSERT_MODULE_ID, __LINE__))
+void assert_compact_failed(uint8_t module, uint16_t line);
+#elif defined(USE_FULL_ASSERT)
 
 #define assert_param(expr) ((expr) ? (void)0 : assert_failed((uint8_t *)__FILE__, __LINE__))
 void assert_failed(uint8_t* file, uint32_t line);
@@ -1,61 +1,38 @@
 #STM8_StdPeriph
 
-STM8_GET_CHIP_TYPE(${STM8_CHIP} STM8_CHIP_TYPE)
+include(sdcc-stm8-split)
 
-if(STM8_CHIP_TYPE MATCHES "10X")
-
-    set(STM8_STD_COMPONENTS
-            awu beep clk comp exti
-            flash gpio i2c irtim
-            itc iwdg rst spi tim2
-            tim3 tim4 usart wfe
-            )
-    set(STM8_STD_PREFIX "stm8l10x")
-    set(STM8_STD_HEADERS ${STM8_STD_PREFIX}.h)
-    set(STM8_STD_SOURCES "")
-    set(STM8_FIND_PREFIX "L10x")
-
-elseif(STM8_CHIP_TYPE MATCHES "05X|15X")
-
-    set(STM8_STD_COMPONENTS
-            adc aes beep clk comp
-            dac dma exti flash gpio
-            i2c irtim itc iwdg lcd
-            pwr rst rtc spi syscfg
-            tim1 tim2 tim3 tim4
-            tim5 usart wfe wwdg
-            )
-
-    set(STM8_STD_PREFIX "stm8l15x")
-    set(STM8_STD_HEADERS ${STM8_STD_PREFIX}.h)
-    set(STM8_STD_SOURCES "")
-    set(STM8_FIND_PREFIX "L15x")
-
-elseif(STM8_CHIP_TYPE MATCHES "[012]0[3578]")
-
-    set(STM8_STD_COMPONENTS
-            adc1 adc2 awu beep can
-            clk exti flash gpio i2c
-            itc iwdg rst spi tim1 tim2
-            tim3 tim4 tim5 tim6 uart1
-            uart2 uart3 uart4 wwdg
-            )
-    set(STM8_STD_PREFIX "stm8s")
-    set(STM8_STD_HEADERS ${STM8_STD_PREFIX}.h)
-    set(STM8_STD_SOURCES "")
-    set(STM8_FIND_PREFIX "S")
+option(STM8_StdPeriph_SPLIT "Build StdPeriph libraries with one module per function" ON)
 
-endif()
+#Components whose assert_param() records the component id and line (USE_COMPACT_ASSERT,
+#see stm8_assert.h) instead of calling assert_failed() with the file name, ALL for all
+set(STM8_StdPeriph_COMPACT_ASSERT "" CACHE STRING "StdPeriph components built with compact assert_param")
+
+#Compact assert component ids: position in this list, 0 is the application.
+#Same on all chips, new components go at the end.
+set(STM8_StdPeriph_ASSERT_IDS
+        app adc adc1 adc2 aes awu beep can clk comp dac dma exti flash gpio i2c irtim itc iwdg
+        lcd pwr rst rtc spi syscfg tim1 tim2 tim3 tim4 tim5 tim6 uart1 uart2 uart3 usart wfe wwdg)
+
+STM8_GET_CHIP_TYPE(${STM8_CHIP} STM8_CHIP_TYPE)
+
+#Components available on the chip and StdPeriph family (S, L10x, L15x) from the chip database
+set(STM8_STD_COMPONENTS ${STM8_TYPE_${STM8_CHIP_TYPE}_COMPONENTS})
+set(STM8_FIND_PREFIX ${STM8_TYPE_${STM8_CHIP_TYPE}_FAMILY})
+string(TOLOWER "stm8${STM8_FIND_PREFIX}" STM8_STD_PREFIX)
+set(STM8_STD_HEADERS ${STM8_STD_PREFIX}.h)
+set(STM8_STD_SOURCES "")
 
 if(NOT STM8_StdPeriph_FIND_COMPONENTS)
     set(STM8_StdPeriph_FIND_COMPONENTS ${STM8_STD_COMPONENTS})
-    message(STATUS "No STM8_StdPeriph components selected, using all available for current series: ${STM8_StdPeriph_FIND_COMPONENTS}")
+    message(STATUS "No STM8_StdPeriph components selected, using all available for ${STM8_CHIP}: ${STM8_StdPeriph_FIND_COMPONENTS}")
 endif()
 
 foreach(COMP ${STM8_StdPeriph_FIND_COMPONENTS})
     list(FIND STM8_STD_COMPONENTS ${COMP} INDEX)
     if(${INDEX} LESS 0)
-        message(FATAL_ERROR "Unknown STM8 component: ${COMP}.")
+        message(FATAL_ERROR "STM8 component ${COMP} is not available on ${STM8_CHIP}. "
+                "Available components: ${STM8_STD_COMPONENTS}")
     else()
         list(APPEND STM8_STD_HEADERS ${STM8_STD_PREFIX}_${COMP}.h)
         list(APPEND STM8_STD_SOURCES ${STM8_STD_PREFIX}_${COMP}.c)
@@ -69,6 +46,11 @@ find_path(STM8_StdPeriph_INCLUDE_DIR ${STM8_STD_HEADERS}
         CMAKE_FIND_ROOT_PATH_BOTH
 )
 
+#Series independent files shared by all series: *_conf.h, stm8_it.h, stm8_ram.c
+find_path(STM8_StdPeriph_COMMON_DIR stm8_it.h
+        PATHS ${STM8_StdPeriph_DIR} ${STM8_StdPeriph_DIR}/..
+        CMAKE_FIND_ROOT_PATH_BOTH
+)
 
 foreach(STD_SRC ${STM8_STD_SOURCES})
     set(STD_${STD_SRC}_FILE STD_SRC_FILE-NOTFOUND)
@@ -79,6 +61,74 @@ foreach(STD_SRC ${STM8_STD_SOURCES})
     list(APPEND STM8_StdPeriph_SOURCES ${STD_${STD_SRC}_FILE})
 endforeach()
 
+#Functions to be executed from RAM, see STM8_ADD_RAM_SEGMENT
+if(STD_${STM8_STD_PREFIX}_flash.c_FILE)
+    set(STM8_StdPeriph_RAM_SOURCES ${STD_${STM8_STD_PREFIX}_flash.c_FILE})
+endif()
+
+#Wear leveled record store in the data EEPROM
+if(NOT STM8_FIND_PREFIX STREQUAL "L10x")
+    set(STM8_StdPeriph_EEPROM_LOG_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_eeprom_log.c)
+endif()
+
+#Compact assert_param fault log
+set(STM8_StdPeriph_ASSERT_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_assert.c)
+
+#Interrupt priority plan and priority critical sections
+set(STM8_StdPeriph_PRIORITY_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_priority.c)
+
+#AES-128 ECB/CBC/CTR through DMA (STM8L16x, component aes)
+if(STM8_FIND_PREFIX STREQUAL "L15x")
+    set(STM8_StdPeriph_AES_DMA_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_aes_dma.c)
+endif()
+
+#Interrupt driven modules, compiled into the executable (they define interrupt handlers)
+set(STM8_StdPeriph_USART_BUFFER_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_usart_buffer.c)
+set(STM8_StdPeriph_I2C_MASTER_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_i2c_master.c)
+set(STM8_StdPeriph_SCHEDULER_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_scheduler.c)
+set(STM8_StdPeriph_SPI_TRANSFER_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_spi_transfer.c)
+if(NOT STM8_FIND_PREFIX STREQUAL "L10x")
+    set(STM8_StdPeriph_CAPTURE_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_capture.c)
+    set(STM8_StdPeriph_PWM_SEQUENCER_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_pwm_sequencer.c)
+endif()
+if(STM8_FIND_PREFIX STREQUAL "L15x")
+    set(STM8_StdPeriph_ADC_STREAM_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_adc_stream.c)
+    set(STM8_StdPeriph_RTC_TIME_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_rtc_time.c)
+elseif(STM8_FIND_PREFIX STREQUAL "S")
+    set(STM8_StdPeriph_ADC1_SCAN_SOURCES ${STM8_StdPeriph_COMMON_DIR}/stm8_adc1_scan.c)
+endif()
+
 include(FindPackageHandleStandardArgs)
 
-FIND_PACKAGE_HANDLE_STANDARD_ARGS(STM8_StdPeriph DEFAULT_MSG STM8_StdPeriph_INCLUDE_DIR STM8_StdPeriph_SOURCES)
\ No newline at end of file
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(STM8_StdPeriph DEFAULT_MSG STM8_StdPeriph_INCLUDE_DIR STM8_StdPeriph_COMMON_DIR STM8_StdPeriph_SOURCES)
+
+#One static library per component, compiled once for STM8_CHIP and shared by
+#all executables of the build tree. sdld only pulls the referenced modules, so
+#with STM8_StdPeriph_SPLIT each driver function is a module of its own.
+if(STM8_StdPeriph_FOUND)
+    set(STM8_StdPeriph_LIBRARIES "")
+    foreach(COMP ${STM8_StdPeriph_FIND_COMPONENTS})
+        set(LIB_TARGET stm8_stdperiph_${COMP})
+        if(NOT TARGET ${LIB_TARGET})
+            set(LIB_SOURCES ${STD_${STM8_STD_PREFIX}_${COMP}.c_FILE})
+            if(STM8_StdPeriph_SPLIT)
+                STM8_SPLIT_SOURCE(${LIB_SOURCES} ${CMAKE_BINARY_DIR}/stm8_stdperiph_split LIB_SOURCES)
+            endif()
+            add_library(${LIB_TARGET} STATIC ${LIB_SOURCES})
+            set_target_properties(${LIB_TARGET} PROPERTIES OUTPUT_NAME ${STM8_CHIP_NAME}_${COMP})
+            target_include_directories(${LIB_TARGET} PUBLIC ${STM8_StdPeriph_INCLUDE_DIR} ${STM8_StdPeriph_COMMON_DIR})
+            STM8_SET_TARGET_PROPERTIES(${LIB_TARGET})
+            if(COMP STREQUAL "flash" AND STM8_RAM_EXECUTION)
+                set_property(TARGET ${LIB_TARGET} APPEND PROPERTY COMPILE_DEFINITIONS RAM_EXECUTION)
+            endif()
+            list(FIND STM8_StdPeriph_COMPACT_ASSERT ${COMP} INDEX)
+            if(STM8_StdPeriph_COMPACT_ASSERT STREQUAL "ALL" OR NOT INDEX LESS 0)
+                list(FIND STM8_StdPeriph_ASSERT_IDS ${COMP} ASSERT_ID)
+                set_property(TARGET ${LIB_TARGET} APPEND PROPERTY COMPILE_DEFINITIONS
+                        USE_COMPACT_ASSERT ASSERT_MODULE_ID=${ASSERT_ID})
+            endif()
+            add_library(STM8::StdPeriph::${COMP} ALIAS ${LIB_TARGET})
+        endif()
+        list(APPEND STM8_StdPeriph_LIBRARIES STM8::StdPeriph::${COMP})
+    endforeach()
+endif()
@@ -0,0 +1,130 @@
+#Runs the benchmark images under ucsim and reports their cycle counts
+#
+#ucsim stops at breakpoints on BENCH_Start and BENCH_Stop (addresses from the
+#.map file) and prints the clocks since reset ("state" command) at each stop.
+#Cycles of a benchmark are the difference, less the one of the first
+#(calibration) benchmark. Results are written to bench.json and bench.csv.
+#
+#Usage: cmake -DUCSIM=<sstm8> -DUCSIM_TYPE=<type> -DCHIP=<chip> -DBENCH_DIR=<dir>
+#             -DBENCHMARKS=<name>,<name>... -DBENCH_<name>=<ihx file>...
+#             [-DBASELINE=<bench.csv>]
+#             [-DTOLERANCE=<percent>] -P sdcc-stm8-bench-run.cmake
+
+foreach(VAR UCSIM UCSIM_TYPE CHIP BENCH_DIR BENCHMARKS)
+    if(NOT DEFINED ${VAR})
+        message(FATAL_ERROR "${VAR} is not defined")
+    endif()
+endforeach()
+if(NOT EXISTS "${UCSIM}")
+    message(FATAL_ERROR "ucsim (sstm8) not found, set STM8_UCSIM")
+endif()
+
+include(${CMAKE_CURRENT_LIST_DIR}/sdcc-stm8-utils.cmake)
+
+#Address of SYMBOL in MAP_FILE as 0x<hex>
+function(STM8_BENCH_GET_ADDRESS MAP_FILE SYMBOL ADDRESS)
+    file(STRINGS ${MAP_FILE} LINES REGEX "[ \t]${SYMBOL}[ \t]")
+    if(NOT LINES MATCHES "^[ \t]+([A-Z]:[ \t]+)?([0-9A-Fa-f]+)[ \t]+${SYMBOL}[ \t]")
+        message(FATAL_ERROR "${SYMBOL} not found in ${MAP_FILE}")
+    endif()
+    set(${ADDRESS} 0x${CMAKE_MATCH_2} PARENT_SCOPE)
+endfunction()
+
+#Cycles between the BENCH_Start and BENCH_Stop breakpoints of NAME
+function(STM8_BENCH_RUN NAME CYCLES)
+    set(IHX_FILE ${BENCH_${NAME}})
+    get_filename_component(IHX_DIR ${IHX_FILE} PATH)
+    get_filename_component(IHX_NAME ${IHX_FILE} NAME_WE)
+    set(MAP_FILE ${IHX_DIR}/${IHX_NAME}.map)
+    STM8_BENCH_GET_ADDRESS(${MAP_FILE} _BENCH_Start START_ADDRESS)
+    STM8_BENCH_GET_ADDRESS(${MAP_FILE} _BENCH_Stop STOP_ADDRESS)
+
+    set(COMMAND_FILE ${BENCH_DIR}/${NAME}.ucsim)
+    file(WRITE ${COMMAND_FILE}
+            "break ${START_ADDRESS}\nbreak ${STOP_ADDRESS}\n"
+            "run\nstate\nrun\nstate\nquit\n")
+    execute_process(COMMAND ${UCSIM} -t ${UCSIM_TYPE} ${IHX_FILE}
+            INPUT_FILE ${COMMAND_FILE}
+            OUTPUT_VARIABLE OUTPUT
+            ERROR_VARIABLE OUTPUT
+            TIMEOUT 60)
+    file(WRITE ${BENCH_DIR}/${NAME}.ucsim.log "${OUTPUT}")
+
+    #Line of the "state" command in <name>.ucsim.log, printed by ucsim as
+    #"Total time since last reset= %g sec (%lu clks)":
+    #  Total time since last reset= 0.000125 sec (250 clks)
+    #The following "Time in isr" and "Time in main program" lines also count clks.
+    string(REGEX MATCHALL "Total time since last reset=[^\n(]*\\([0-9]+ clks\\)" STATES "${OUTPUT}")
+    list(LENGTH STATES STATE_COUNT)
+    if(NOT STATE_COUNT EQUAL 2)
+        message(FATAL_ERROR "Benchmark ${NAME} didn't stop at BENCH_Start and BENCH_Stop, "
+                "see ${BENCH_DIR}/${NAME}.ucsim.log")
+    endif()
+    list(GET STATES 0 START_STATE)
+    list(GET STATES 1 STOP_STATE)
+    string(REGEX REPLACE "^.*\\(([0-9]+) clks\\)$" "\\1" START_CLOCKS "${START_STATE}")
+    string(REGEX REPLACE "^.*\\(([0-9]+) clks\\)$" "\\1" STOP_CLOCKS "${STOP_STATE}")
+    math(EXPR RESULT "${STOP_CLOCKS} - ${START_CLOCKS}")
+    set(${CYCLES} ${RESULT} PARENT_SCOPE)
+endfunction()
+
+#Baseline cycles: BASELINE_<name>
+if(BASELINE)
+    file(STRINGS ${BASELINE} BASELINE_LINES)
+    foreach(LINE IN LISTS BASELINE_LINES)
+        if(LINE MATCHES "^([A-Za-z0-9_]+),([0-9]+)")
+            set(BASELINE_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+        endif()
+    endforeach()
+endif()
+
+string(REPLACE "," ";" BENCHMARKS "${BENCHMARKS}")
+list(GET BENCHMARKS 0 CALIBRATION)
+list(REMOVE_AT BENCHMARKS 0)
+STM8_BENCH_RUN(${CALIBRATION} OVERHEAD)
+
+set(CSV "benchmark,cycles,baseline,delta\n")
+set(JSON "")
+set(REPORT "")
+set(REGRESSIONS "")
+foreach(NAME ${BENCHMARKS})
+    STM8_BENCH_RUN(${NAME} RAW_CYCLES)
+    math(EXPR CYCLES "${RAW_CYCLES} - ${OVERHEAD}")
+
+    set(BASE "")
+    set(DELTA "")
+    set(JSON_BASE "null")
+    set(JSON_DELTA "null")
+    set(REPORT_DELTA "")
+    if(DEFINED BASELINE_${NAME})
+        set(BASE ${BASELINE_${NAME}})
+        math(EXPR DELTA "${CYCLES} - ${BASE}")
+        set(JSON_BASE ${BASE})
+        set(JSON_DELTA ${DELTA})
+        set(REPORT_DELTA " (baseline ${BASE}, ${DELTA})")
+        if(NOT TOLERANCE STREQUAL "" AND BASE GREATER 0)
+            math(EXPR LIMIT "${BASE} + ${BASE} * ${TOLERANCE} / 100")
+            if(CYCLES GREATER LIMIT)
+                set(REGRESSIONS "${REGRESSIONS}${NAME}: ${CYCLES} cycles, baseline ${BASE}\n")
+            endif()
+        endif()
+    endif()
+
+    set(CSV "${CSV}${NAME},${CYCLES},${BASE},${DELTA}\n")
+    if(JSON)
+        set(JSON "${JSON},\n")
+    endif()
+    set(JSON "${JSON}    {\"name\": \"${NAME}\", \"cycles\": ${CYCLES}, \"baseline\": ${JSON_BASE}, \"delta\": ${JSON_DELTA}}")
+    set(REPORT "${REPORT}${NAME}: ${CYCLES} cycles${REPORT_DELTA}\n")
+endforeach()
+
+file(WRITE ${BENCH_DIR}/bench.csv "${CSV}")
+file(WRITE ${BENCH_DIR}/bench.json
+        "{\n  \"chip\": \"${CHIP}\",\n  \"simulator\": \"${UCSIM_TYPE}\",\n"
+        "  \"overhead\": ${OVERHEAD},\n  \"benchmarks\": [\n${JSON}\n  ]\n}\n")
+message("${CHIP} (${UCSIM_TYPE}), ${OVERHEAD} cycles overhead subtracted:\n${REPORT}"
+        "Results: ${BENCH_DIR}/bench.json, ${BENCH_DIR}/bench.csv")
+
+if(REGRESSIONS)
+    message(FATAL_ERROR "Slower than baseline by more than ${TOLERANCE}%:\n${REGRESSIONS}")
+endif()
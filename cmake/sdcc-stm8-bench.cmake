@@ -0,0 +1,77 @@
+#Cycle count benchmarks of STM8_CHIP images under the ucsim simulator (sstm8)
+#
+#Each benchmark is a firmware image of its own, see stm8-bench/bench.h. The
+#bench target runs them with sdcc-stm8-bench-run.cmake and writes bench.json and
+#bench.csv, compared with STM8_BENCH_BASELINE (a bench.csv of a previous run).
+
+get_filename_component(SDCC_LOCATION "${CMAKE_C_COMPILER}" PATH)
+find_program(STM8_UCSIM NAMES sstm8 ucsim_stm8 HINTS "${SDCC_LOCATION}")
+
+if(STM8_TYPE_${STM8_CHIP_TYPE}_FAMILY STREQUAL "S")
+    set(STM8_UCSIM_DEFAULT_TYPE STM8S)
+elseif(STM8_TYPE_${STM8_CHIP_TYPE}_FAMILY STREQUAL "L10x")
+    set(STM8_UCSIM_DEFAULT_TYPE STM8L101)
+else()
+    set(STM8_UCSIM_DEFAULT_TYPE STM8L)
+endif()
+set(STM8_UCSIM_TYPE ${STM8_UCSIM_DEFAULT_TYPE} CACHE STRING "ucsim CPU type (sstm8 -t)")
+set(STM8_BENCH_BASELINE "" CACHE FILEPATH "bench.csv of a previous run to compare with")
+set(STM8_BENCH_TOLERANCE "" CACHE STRING "Fail the bench target when a benchmark is slower than the baseline by more than this percentage")
+
+set(STM8_BENCHMARKS "")
+
+#STM8_ADD_BENCHMARK(<name> <sources>... [COMPONENTS <StdPeriph component>...])
+#Benchmarks using components STM8_CHIP doesn't have are skipped.
+function(STM8_ADD_BENCHMARK NAME)
+    set(SOURCES "")
+    set(COMPONENT_LIST "")
+    set(LIST_NAME SOURCES)
+    foreach(ARG ${ARGN})
+        if(ARG STREQUAL "COMPONENTS")
+            set(LIST_NAME COMPONENT_LIST)
+        else()
+            list(APPEND ${LIST_NAME} ${ARG})
+        endif()
+    endforeach()
+
+    set(LIBRARIES "")
+    foreach(COMP ${COMPONENT_LIST})
+        list(FIND STM8_TYPE_${STM8_CHIP_TYPE}_COMPONENTS ${COMP} INDEX)
+        if(INDEX EQUAL -1)
+            message(STATUS "Benchmark ${NAME} skipped, ${COMP} is not available on ${STM8_CHIP}")
+            return()
+        endif()
+        list(APPEND LIBRARIES STM8::StdPeriph::${COMP})
+    endforeach()
+
+    add_executable(${NAME} ${SOURCES})
+    target_link_libraries(${NAME} ${LIBRARIES})
+    STM8_SET_TARGET_PROPERTIES(${NAME})
+
+    list(APPEND STM8_BENCHMARKS ${NAME})
+    set(STM8_BENCHMARKS ${STM8_BENCHMARKS} PARENT_SCOPE)
+endfunction()
+
+#Adds the bench target running all benchmarks, the first one is the calibration
+#(empty) benchmark subtracted from the others
+function(STM8_ADD_BENCHMARK_TARGET)
+    string(REPLACE ";" "," BENCHMARK_NAMES "${STM8_BENCHMARKS}")
+    set(BENCHMARK_FILES "")
+    foreach(NAME ${STM8_BENCHMARKS})
+        list(APPEND BENCHMARK_FILES -DBENCH_${NAME}=$<TARGET_FILE:${NAME}>)
+    endforeach()
+    add_custom_target(bench
+            COMMAND ${CMAKE_COMMAND}
+                -DUCSIM=${STM8_UCSIM}
+                -DUCSIM_TYPE=${STM8_UCSIM_TYPE}
+                -DCHIP=${STM8_CHIP_NAME}
+                -DBENCH_DIR=${CMAKE_CURRENT_BINARY_DIR}
+                -DBENCHMARKS=${BENCHMARK_NAMES}
+                ${BENCHMARK_FILES}
+                -DBASELINE=${STM8_BENCH_BASELINE}
+                -DTOLERANCE=${STM8_BENCH_TOLERANCE}
+                -P ${STM8_CMAKE_DIR}/sdcc-stm8-bench-run.cmake
+            DEPENDS ${STM8_BENCHMARKS}
+            WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+            COMMENT "Running benchmarks under ucsim")
+endfunction()
@@ -0,0 +1,76 @@
+#Moves the RAM_SEG image of an .ihx file to its Flash load address
+#
+#RAM_SEG is linked at its RAM address (RAM_SEG_ADDRESS), so the linker emits
+#its code as records in the RAM range. They are relocated to RAM_SEG_LOAD, from
+#where RAM_SEG_Load() (stm8_ram.c) copies them back at startup.
+#
+#Usage: cmake -DIHX_FILE=<file> -DRAM_SEG_ADDRESS=0x.. -DRAM_SEG_LOAD=0x..
+#             -DRAM_SEG_SIZE=<bytes> -P sdcc-stm8-ramseg.cmake
+
+include(${CMAKE_CURRENT_LIST_DIR}/sdcc-stm8-utils.cmake)
+
+foreach(VAR IHX_FILE RAM_SEG_ADDRESS RAM_SEG_LOAD RAM_SEG_SIZE)
+    if(NOT DEFINED ${VAR})
+        message(FATAL_ERROR "${VAR} is not defined")
+    endif()
+endforeach()
+
+STM8_HEX_TO_DEC(${RAM_SEG_ADDRESS} SEG_START)
+STM8_HEX_TO_DEC(${RAM_SEG_LOAD} LOAD_START)
+math(EXPR SEG_END "${SEG_START} + ${RAM_SEG_SIZE}")
+math(EXPR LOAD_END "${LOAD_START} + ${RAM_SEG_SIZE}")
+
+file(STRINGS ${IHX_FILE} IHX_LINES)
+
+set(OUTPUT "")
+set(ULBA 0)
+set(SEG_USED 0)
+foreach(LINE ${IHX_LINES})
+    string(REGEX REPLACE "[\r\n]" "" LINE "${LINE}")
+    string(SUBSTRING ${LINE} 1 2 LEN_HEX)
+    string(SUBSTRING ${LINE} 3 4 ADDR_HEX)
+    string(SUBSTRING ${LINE} 7 2 TYPE_HEX)
+    STM8_HEX_TO_DEC(${LEN_HEX} LEN)
+    STM8_HEX_TO_DEC(${ADDR_HEX} ADDR)
+    math(EXPR DATA_LEN "${LEN} * 2")
+    string(SUBSTRING ${LINE} 9 ${DATA_LEN} DATA_HEX)
+    math(EXPR REC_END "${ADDR} + ${LEN}")
+
+    if(TYPE_HEX STREQUAL "04")
+        STM8_HEX_TO_DEC(${DATA_HEX} ULBA)
+    elseif(TYPE_HEX STREQUAL "00" AND ULBA EQUAL 0)
+        if(NOT ADDR LESS SEG_START AND ADDR LESS SEG_END)
+            if(REC_END GREATER SEG_END)
+                message(FATAL_ERROR "RAM_SEG exceeds STM8_RAM_SEG_SIZE (${RAM_SEG_SIZE} bytes)")
+            endif()
+            if(REC_END GREATER SEG_USED)
+                set(SEG_USED ${REC_END})
+            endif()
+
+            math(EXPR ADDR "${LOAD_START} + ${ADDR} - ${SEG_START}")
+            STM8_DEC_TO_HEX(${ADDR} 4 ADDR_HEX)
+            math(EXPR SUM "${LEN} + ${ADDR} / 256 + ${ADDR} % 256")
+            set(INDEX 0)
+            while(INDEX LESS DATA_LEN)
+                string(SUBSTRING ${DATA_HEX} ${INDEX} 2 BYTE_HEX)
+                STM8_HEX_TO_DEC(${BYTE_HEX} BYTE)
+                math(EXPR SUM "${SUM} + ${BYTE}")
+                math(EXPR INDEX "${INDEX} + 2")
+            endwhile()
+            math(EXPR CHECKSUM "(256 - ${SUM} % 256) % 256")
+            STM8_DEC_TO_HEX(${CHECKSUM} 2 CHECKSUM_HEX)
+            set(LINE ":${LEN_HEX}${ADDR_HEX}00${DATA_HEX}${CHECKSUM_HEX}")
+        elseif(ADDR LESS LOAD_END AND REC_END GREATER LOAD_START)
+            message(FATAL_ERROR "Code at 0x${ADDR_HEX} overlaps the RAM_SEG load area ${RAM_SEG_LOAD}, "
+                    "reduce STM8_RAM_SEG_SIZE or the application size")
+        endif()
+    endif()
+    set(OUTPUT "${OUTPUT}${LINE}\n")
+endforeach()
+
+if(SEG_USED GREATER 0)
+    math(EXPR SEG_USED "${SEG_USED} - ${SEG_START}")
+endif()
+message(STATUS "RAM_SEG: ${SEG_USED} of ${RAM_SEG_SIZE} bytes, loaded from ${RAM_SEG_LOAD} to ${RAM_SEG_ADDRESS}")
+
+file(WRITE ${IHX_FILE} "${OUTPUT}")
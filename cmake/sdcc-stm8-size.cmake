@@ -0,0 +1,196 @@
+#Flash and RAM usage of an executable from its sdld .map file
+#
+#Areas are counted by address: Flash from 0x8000, RAM below RAM_SIZE, RAM_SEG
+#in both (its image is stored in Flash). Function sizes are the distance to the
+#next global symbol of the area, so static functions are included in the
+#preceding global one. The full report is written to REPORT_FILE, the build
+#fails when FLASH_BUDGET or RAM_BUDGET is exceeded.
+#
+#Usage: cmake -DIHX_FILE=<file> -DREPORT_FILE=<file> -DFLASH_SIZE=<bytes>
+#             -DRAM_SIZE=<bytes> -DSTACK_SIZE=<bytes> -DFLASH_BUDGET=<bytes>
+#             -DRAM_BUDGET=<bytes> -P sdcc-stm8-size.cmake
+
+include(${CMAKE_CURRENT_LIST_DIR}/sdcc-stm8-utils.cmake)
+
+foreach(VAR IHX_FILE REPORT_FILE FLASH_SIZE RAM_SIZE STACK_SIZE FLASH_BUDGET RAM_BUDGET)
+    if(NOT DEFINED ${VAR})
+        message(FATAL_ERROR "${VAR} is not defined")
+    endif()
+endforeach()
+
+#Left aligned TEXT padded to WIDTH characters (right aligned for negative WIDTH)
+function(STM8_SIZE_PAD TEXT WIDTH OUT)
+    set(RESULT "${TEXT}")
+    string(LENGTH "${RESULT}" LEN)
+    if(WIDTH LESS 0)
+        math(EXPR WIDTH "0 - ${WIDTH}")
+        while(LEN LESS WIDTH)
+            set(RESULT " ${RESULT}")
+            math(EXPR LEN "${LEN} + 1")
+        endwhile()
+    else()
+        while(LEN LESS WIDTH)
+            set(RESULT "${RESULT} ")
+            math(EXPR LEN "${LEN} + 1")
+        endwhile()
+    endif()
+    set(${OUT} "${RESULT}" PARENT_SCOPE)
+endfunction()
+
+#"<used> of <limit> bytes (<percent>%)"
+function(STM8_SIZE_USAGE USED LIMIT OUT)
+    if(LIMIT GREATER 0)
+        math(EXPR PERMILLE "${USED} * 1000 / ${LIMIT}")
+        math(EXPR PERCENT "${PERMILLE} / 10")
+        math(EXPR PERCENT_FRACTION "${PERMILLE} % 10")
+        set(${OUT} "${USED} of ${LIMIT} bytes (${PERCENT}.${PERCENT_FRACTION}%)" PARENT_SCOPE)
+    else()
+        set(${OUT} "${USED} bytes" PARENT_SCOPE)
+    endif()
+endfunction()
+
+get_filename_component(IHX_DIR ${IHX_FILE} PATH)
+get_filename_component(IHX_NAME ${IHX_FILE} NAME_WE)
+set(MAP_FILE ${IHX_DIR}/${IHX_NAME}.map)
+if(NOT EXISTS ${MAP_FILE})
+    message(FATAL_ERROR "${MAP_FILE} not found")
+endif()
+
+file(STRINGS ${MAP_FILE} MAP_LINES)
+
+#Areas: AREA_<name>_CLASS (FLASH, RAM, FLASH_RAM or OTHER), AREA_<name>_END.
+#Symbols: "<address>|<symbol>|<module>|<area>", address 8 hex digits to sort.
+set(AREAS "")
+set(SYMBOLS "")
+set(AREA "")
+set(FLASH_USED 0)
+set(RAM_USED 0)
+foreach(LINE IN LISTS MAP_LINES)
+    if(LINE MATCHES "^([A-Za-z_.$][A-Za-z0-9_.$]*)[ \t]+([0-9A-Fa-f]+)[ \t]+([0-9A-Fa-f]+)[ \t]+=[ \t]+([0-9]+)\\. bytes")
+        set(AREA ${CMAKE_MATCH_1})
+        set(AREA_SIZE ${CMAKE_MATCH_4})
+        STM8_HEX_TO_DEC(${CMAKE_MATCH_2} AREA_ADDR)
+        if(AREA_SIZE EQUAL 0 OR AREA STREQUAL "SSEG" OR AREA STREQUAL ".ABS.")
+            set(AREA "")
+        else()
+            if(AREA STREQUAL "RAM_SEG")
+                set(CLASS FLASH_RAM)
+                math(EXPR FLASH_USED "${FLASH_USED} + ${AREA_SIZE}")
+                math(EXPR RAM_USED "${RAM_USED} + ${AREA_SIZE}")
+            elseif(NOT AREA_ADDR LESS 32768)
+                set(CLASS FLASH)
+                math(EXPR FLASH_USED "${FLASH_USED} + ${AREA_SIZE}")
+            elseif(AREA_ADDR LESS RAM_SIZE)
+                set(CLASS RAM)
+                math(EXPR RAM_USED "${RAM_USED} + ${AREA_SIZE}")
+            else()
+                set(CLASS OTHER)
+            endif()
+            list(APPEND AREAS ${AREA})
+            set(AREA_${AREA}_CLASS ${CLASS})
+            set(AREA_${AREA}_SIZE ${AREA_SIZE})
+            math(EXPR AREA_${AREA}_END "${AREA_ADDR} + ${AREA_SIZE}")
+        endif()
+    elseif(LINE MATCHES "^Files Linked")
+        set(AREA "")
+    elseif(AREA AND LINE MATCHES "^[ \t]+([A-Z]:[ \t]+)?([0-9A-Fa-f]+)[ \t]+([A-Za-z_.$][A-Za-z0-9_.$]*)[ \t]+([^ \t]+)[ \t]*$")
+        set(SYMBOL_HEX ${CMAKE_MATCH_2})
+        set(SYMBOL ${CMAKE_MATCH_3})
+        set(MODULE ${CMAKE_MATCH_4})
+        if(NOT SYMBOL MATCHES "^(s_|l_|\\.__\\.)")
+            STM8_HEX_TO_DEC(${SYMBOL_HEX} SYMBOL_ADDR)
+            STM8_DEC_TO_HEX(${SYMBOL_ADDR} 8 SYMBOL_HEX)
+            list(APPEND SYMBOLS "${SYMBOL_HEX}|${SYMBOL}|${MODULE}|${AREA}")
+        endif()
+    endif()
+endforeach()
+
+list(SORT SYMBOLS)
+list(LENGTH SYMBOLS SYMBOL_COUNT)
+
+#Symbol sizes up to the next symbol of the same area, totals per module
+set(MODULES "")
+set(FUNCTION_LINES "")
+set(INDEX 0)
+while(INDEX LESS SYMBOL_COUNT)
+    list(GET SYMBOLS ${INDEX} ENTRY)
+    string(REPLACE "|" ";" ENTRY "${ENTRY}")
+    list(GET ENTRY 0 SYMBOL_HEX)
+    list(GET ENTRY 1 SYMBOL)
+    list(GET ENTRY 2 MODULE)
+    list(GET ENTRY 3 AREA)
+    STM8_HEX_TO_DEC(${SYMBOL_HEX} SYMBOL_ADDR)
+
+    set(SYMBOL_END ${AREA_${AREA}_END})
+    math(EXPR INDEX "${INDEX} + 1")
+    if(INDEX LESS SYMBOL_COUNT)
+        list(GET SYMBOLS ${INDEX} NEXT)
+        string(REPLACE "|" ";" NEXT "${NEXT}")
+        list(GET NEXT 3 NEXT_AREA)
+        if(NEXT_AREA STREQUAL AREA)
+            list(GET NEXT 0 NEXT_HEX)
+            STM8_HEX_TO_DEC(${NEXT_HEX} SYMBOL_END)
+        endif()
+    endif()
+    math(EXPR SYMBOL_SIZE "${SYMBOL_END} - ${SYMBOL_ADDR}")
+
+    list(FIND MODULES ${MODULE} MODULE_INDEX)
+    if(MODULE_INDEX EQUAL -1)
+        list(APPEND MODULES ${MODULE})
+        set(MODULE_${MODULE}_FLASH 0)
+        set(MODULE_${MODULE}_RAM 0)
+    endif()
+    set(CLASS ${AREA_${AREA}_CLASS})
+    if(CLASS MATCHES "FLASH")
+        math(EXPR MODULE_${MODULE}_FLASH "${MODULE_${MODULE}_FLASH} + ${SYMBOL_SIZE}")
+    endif()
+    if(CLASS MATCHES "RAM")
+        math(EXPR MODULE_${MODULE}_RAM "${MODULE_${MODULE}_RAM} + ${SYMBOL_SIZE}")
+    endif()
+
+    STM8_SIZE_PAD("${SYMBOL}" 40 SYMBOL_COL)
+    STM8_SIZE_PAD("${AREA}" 14 AREA_COL)
+    STM8_SIZE_PAD("${SYMBOL_SIZE}" -8 SIZE_COL)
+    set(FUNCTION_LINES "${FUNCTION_LINES}${SYMBOL_COL}${AREA_COL}${SIZE_COL}  ${MODULE}\n")
+endwhile()
+
+list(SORT MODULES)
+STM8_SIZE_PAD("Module" 40 MODULE_COL)
+set(MODULE_LINES "${MODULE_COL}   Flash     RAM\n")
+foreach(MODULE ${MODULES})
+    STM8_SIZE_PAD("${MODULE}" 40 MODULE_COL)
+    STM8_SIZE_PAD("${MODULE_${MODULE}_FLASH}" -8 FLASH_COL)
+    STM8_SIZE_PAD("${MODULE_${MODULE}_RAM}" -8 RAM_COL)
+    set(MODULE_LINES "${MODULE_LINES}${MODULE_COL}${FLASH_COL}${RAM_COL}\n")
+endforeach()
+
+STM8_SIZE_PAD("Area" 40 AREA_COL)
+set(AREA_LINES "${AREA_COL}    Size  Memory\n")
+foreach(AREA ${AREAS})
+    STM8_SIZE_PAD("${AREA}" 40 AREA_COL)
+    STM8_SIZE_PAD("${AREA_${AREA}_SIZE}" -8 SIZE_COL)
+    set(AREA_LINES "${AREA_LINES}${AREA_COL}${SIZE_COL}  ${AREA_${AREA}_CLASS}\n")
+endforeach()
+
+math(EXPR RAM_LIMIT "${RAM_SIZE} - ${STACK_SIZE}")
+STM8_SIZE_USAGE(${FLASH_USED} ${FLASH_SIZE} FLASH_USAGE)
+STM8_SIZE_USAGE(${RAM_USED} ${RAM_LIMIT} RAM_USAGE)
+set(SUMMARY "Flash: ${FLASH_USAGE}, budget ${FLASH_BUDGET}\nRAM:   ${RAM_USAGE} (${STACK_SIZE} bytes stack), budget ${RAM_BUDGET}\n")
+
+STM8_SIZE_PAD("Symbol" 40 SYMBOL_COL)
+STM8_SIZE_PAD("Area" 14 AREA_COL)
+file(WRITE ${REPORT_FILE} "${IHX_NAME}\n\n${SUMMARY}\n${AREA_LINES}\n${MODULE_LINES}\n"
+        "${SYMBOL_COL}${AREA_COL}    Size  Module\n${FUNCTION_LINES}")
+
+message("${IHX_NAME} size (${REPORT_FILE}):\n${SUMMARY}\n${MODULE_LINES}")
+
+set(OVER_BUDGET "")
+if(FLASH_USED GREATER FLASH_BUDGET)
+    set(OVER_BUDGET "${OVER_BUDGET}Flash usage ${FLASH_USED} exceeds budget ${FLASH_BUDGET} bytes\n")
+endif()
+if(RAM_USED GREATER RAM_BUDGET)
+    set(OVER_BUDGET "${OVER_BUDGET}RAM usage ${RAM_USED} exceeds budget ${RAM_BUDGET} bytes\n")
+endif()
+if(OVER_BUDGET)
+    message(FATAL_ERROR "${OVER_BUDGET}")
+endif()
@@ -0,0 +1,206 @@
+#Splits a StdPeriph driver source into one translation unit per public function
+#
+#sdld links whole modules, so a driver compiled as a single .rel brings all its
+#functions into the image. Each generated unit is the original file with the
+#other functions blanked out (line numbers, and so assert_param, are kept):
+# - static helpers are kept only in the units calling them
+# - initialized global data is defined in <driver>_data.c and declared extern
+#   in the function units
+
+#The stamp of a split records the splitter it was made with
+set(STM8_SPLIT_SCRIPT ${CMAKE_CURRENT_LIST_FILE})
+file(SHA1 ${STM8_SPLIT_SCRIPT} STM8_SPLIT_SCRIPT_HASH)
+
+string(ASCII 1 STM8_SPLIT_SEMI)
+string(ASCII 2 STM8_SPLIT_BSL)
+string(ASCII 3 STM8_SPLIT_LBR)
+string(ASCII 4 STM8_SPLIT_RBR)
+
+function(STM8_SPLIT_WRITE FILE TEXT)
+    string(REPLACE "${STM8_SPLIT_SEMI}" ";" TEXT "${TEXT}")
+    string(REPLACE "${STM8_SPLIT_LBR}" "[" TEXT "${TEXT}")
+    string(REPLACE "${STM8_SPLIT_RBR}" "]" TEXT "${TEXT}")
+    string(REPLACE "${STM8_SPLIT_BSL}" "\\" TEXT "${TEXT}")
+    file(WRITE ${FILE} "${TEXT}")
+endfunction()
+
+#Returns the generated sources of SRC in SPLIT_SOURCES, SRC is split again only
+#when it is newer than the previous split or the splitter has changed
+function(STM8_SPLIT_SOURCE SRC OUT_DIR SPLIT_SOURCES)
+    get_filename_component(SRC_NAME ${SRC} NAME_WE)
+    set(SPLIT_DIR ${OUT_DIR}/${SRC_NAME})
+    set(STAMP ${SPLIT_DIR}/split.stamp)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${SRC} ${STM8_SPLIT_SCRIPT})
+    if(EXISTS ${STAMP} AND ${STAMP} IS_NEWER_THAN ${SRC})
+        #Stamp: splitter hash followed by the generated sources
+        file(READ ${STAMP} RESULT)
+        list(GET RESULT 0 HASH)
+        if(HASH STREQUAL STM8_SPLIT_SCRIPT_HASH)
+            list(REMOVE_AT RESULT 0)
+            set(${SPLIT_SOURCES} ${RESULT} PARENT_SCOPE)
+            return()
+        endif()
+    endif()
+
+    file(READ ${SRC} CONTENT)
+    string(REPLACE "\\" "${STM8_SPLIT_BSL}" CONTENT "${CONTENT}")
+    string(REPLACE ";" "${STM8_SPLIT_SEMI}" CONTENT "${CONTENT}")
+    string(REPLACE "[" "${STM8_SPLIT_LBR}" CONTENT "${CONTENT}")
+    string(REPLACE "]" "${STM8_SPLIT_RBR}" CONTENT "${CONTENT}")
+    string(REPLACE "\n" ";" LINES "${CONTENT}")
+
+    #The file is cut into chunks: TEXT_<n> (extern variant TEXTX_<n>) followed by
+    #the function FUNC_<n> (blanked variant BLANK_<n>)
+    set(STATE "top")
+    set(IN_COMMENT FALSE)
+    set(HAS_DATA FALSE)
+    set(COUNT 0)
+    set(TEXT "")
+    set(TEXTX "")
+    set(PENDING "")
+    set(PENDING_BLANK "")
+    set(NAMES "")
+    set(LINE_NUMBER 0)
+    foreach(LINE IN LISTS LINES)
+        math(EXPR LINE_NUMBER "${LINE_NUMBER} + 1")
+        set(CODE_LINE FALSE)
+        if(NOT IN_COMMENT AND LINE MATCHES "^[A-Za-z_]")
+            set(CODE_LINE TRUE)
+        endif()
+        #Braces opened minus braces closed by the code of the line, without
+        #comments and literals
+        set(CODE "${LINE}")
+        if(IN_COMMENT)
+            if(CODE MATCHES "\\*/")
+                string(REGEX REPLACE "^([^*]|\\*+[^*/])*\\*+/" "" CODE "${CODE}")
+            else()
+                set(CODE "")
+            endif()
+        endif()
+        string(REGEX REPLACE "/\\*([^*]|\\*+[^*/])*\\*+/" "" CODE "${CODE}")
+        string(REGEX REPLACE "(//|/\\*).*$" "" CODE "${CODE}")
+        string(REGEX REPLACE "\"([^\"${STM8_SPLIT_BSL}]|${STM8_SPLIT_BSL}.)*\"" "" CODE "${CODE}")
+        string(REGEX REPLACE "'([^'${STM8_SPLIT_BSL}]|${STM8_SPLIT_BSL}.)*'" "" CODE "${CODE}")
+        string(REGEX REPLACE "[^{]" "" OPENED "${CODE}")
+        string(REGEX REPLACE "[^}]" "" CLOSED "${CODE}")
+        string(LENGTH "${OPENED}" OPENED)
+        string(LENGTH "${CLOSED}" CLOSED)
+        if(LINE MATCHES "/\\*" AND NOT LINE MATCHES "/\\*.*\\*/[^/]*$")
+            set(IN_COMMENT TRUE)
+        elseif(LINE MATCHES "\\*/")
+            set(IN_COMMENT FALSE)
+        endif()
+
+        if(STATE STREQUAL "top" AND CODE_LINE)
+            set(STATE "statement")
+            set(PENDING "")
+            set(PENDING_BLANK "")
+        endif()
+        #A function body starts at a { in column 0 and ends with its matching }
+        if(STATE STREQUAL "statement" AND LINE MATCHES "^{")
+            set(STATE "function")
+            set(DEPTH 0)
+        endif()
+
+        if(STATE STREQUAL "top")
+            set(TEXT "${TEXT}${LINE}\n")
+            set(TEXTX "${TEXTX}${LINE}\n")
+        elseif(STATE STREQUAL "statement")
+            set(PENDING "${PENDING}${LINE}\n")
+            set(PENDING_BLANK "${PENDING_BLANK}\n")
+            if(LINE MATCHES "${STM8_SPLIT_SEMI}")
+                set(TEXT "${TEXT}${PENDING}")
+                if(PENDING MATCHES "^[^(]*=" AND NOT PENDING MATCHES "^(static|typedef)")
+                    #initialized global data: extern declaration in function units
+                    string(REGEX REPLACE "^([^=]*[^= \t])[ \t]*=.*$" "extern \\1${STM8_SPLIT_SEMI}" DECL "${PENDING}")
+                    string(REGEX REPLACE "\n" "" DECL "${DECL}")
+                    string(LENGTH "${PENDING_BLANK}" BLANK_LEN)
+                    math(EXPR BLANK_LEN "${BLANK_LEN} - 1")
+                    string(SUBSTRING "${PENDING_BLANK}" 1 ${BLANK_LEN} PENDING_BLANK)
+                    set(TEXTX "${TEXTX}${DECL}\n${PENDING_BLANK}")
+                    set(HAS_DATA TRUE)
+                else()
+                    set(TEXTX "${TEXTX}${PENDING}")
+                endif()
+                set(STATE "top")
+            endif()
+        else()
+            set(PENDING "${PENDING}${LINE}\n")
+            set(PENDING_BLANK "${PENDING_BLANK}\n")
+            if(LINE MATCHES "^{" AND NOT DEPTH EQUAL 0)
+                #Two definitions would end up in the same unit
+                message(FATAL_ERROR "${SRC}:${LINE_NUMBER}: function body starts before "
+                        "the previous one is closed, cannot split")
+            endif()
+            math(EXPR DEPTH "${DEPTH} + ${OPENED} - ${CLOSED}")
+            if(DEPTH EQUAL 0)
+                string(REGEX REPLACE "^IN_RAM\\(" "" SIGNATURE "${PENDING}")
+                string(REGEX MATCH "[A-Za-z_][A-Za-z0-9_]*[ \t]*\\(" NAME "${SIGNATURE}")
+                string(REGEX REPLACE "[ \t]*\\($" "" NAME "${NAME}")
+                set(TEXT_${COUNT} "${TEXT}")
+                set(TEXTX_${COUNT} "${TEXTX}")
+                set(FUNC_${COUNT} "${PENDING}")
+                set(BLANK_${COUNT} "${PENDING_BLANK}")
+                set(NAME_${COUNT} ${NAME})
+                set(STATIC_${COUNT} FALSE)
+                if(PENDING MATCHES "^static")
+                    set(STATIC_${COUNT} TRUE)
+                else()
+                    list(APPEND NAMES ${NAME})
+                endif()
+                math(EXPR COUNT "${COUNT} + 1")
+                set(TEXT "")
+                set(TEXTX "")
+                set(STATE "top")
+            endif()
+        endif()
+    endforeach()
+    if(STATE STREQUAL "function")
+        message(FATAL_ERROR "${SRC}: the last function body is not closed, cannot split")
+    endif()
+    #CMake lists drop the last newline of the file
+    string(REGEX REPLACE "\n$" "" TEXT "${TEXT}")
+    string(REGEX REPLACE "\n$" "" TEXTX "${TEXTX}")
+
+    if(COUNT EQUAL 0)
+        message(FATAL_ERROR "No functions found in ${SRC}")
+    endif()
+    math(EXPR LAST "${COUNT} - 1")
+    list(REMOVE_DUPLICATES NAMES)
+
+    file(REMOVE_RECURSE ${SPLIT_DIR})
+    set(RESULT "")
+    foreach(NAME ${NAMES})
+        set(FUNCTIONS "")
+        foreach(INDEX RANGE ${LAST})
+            if(NAME_${INDEX} STREQUAL NAME)
+                set(FUNCTIONS "${FUNCTIONS}${FUNC_${INDEX}}")
+            endif()
+        endforeach()
+        set(UNIT "")
+        foreach(INDEX RANGE ${LAST})
+            set(UNIT "${UNIT}${TEXTX_${INDEX}}")
+            if(NAME_${INDEX} STREQUAL NAME)
+                set(UNIT "${UNIT}${FUNC_${INDEX}}")
+            elseif(STATIC_${INDEX} AND FUNCTIONS MATCHES "[^A-Za-z0-9_]${NAME_${INDEX}}[ \t]*\\(")
+                set(UNIT "${UNIT}${FUNC_${INDEX}}")
+            else()
+                set(UNIT "${UNIT}${BLANK_${INDEX}}")
+            endif()
+        endforeach()
+        STM8_SPLIT_WRITE(${SPLIT_DIR}/${NAME}.c "${UNIT}${TEXTX}")
+        list(APPEND RESULT ${SPLIT_DIR}/${NAME}.c)
+    endforeach()
+
+    if(HAS_DATA)
+        set(UNIT "")
+        foreach(INDEX RANGE ${LAST})
+            set(UNIT "${UNIT}${TEXT_${INDEX}}${BLANK_${INDEX}}")
+        endforeach()
+        STM8_SPLIT_WRITE(${SPLIT_DIR}/${SRC_NAME}_data.c "${UNIT}${TEXT}")
+        list(APPEND RESULT ${SPLIT_DIR}/${SRC_NAME}_data.c)
+    endif()
+
+    file(WRITE ${STAMP} "${STM8_SPLIT_SCRIPT_HASH};${RESULT}")
+    set(${SPLIT_SOURCES} ${RESULT} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,37 @@
+#Helpers shared by the sdcc-stm8 modules and their cmake -P scripts
+#(kept compatible with cmake 2.8 math, which has no hexadecimal support)
+
+set(STM8_HEX_DIGITS "0123456789ABCDEF")
+
+function(STM8_HEX_TO_DEC HEX DEC)
+    string(TOUPPER ${HEX} HEX_UPPER)
+    string(REGEX REPLACE "^0X" "" HEX_UPPER ${HEX_UPPER})
+    string(LENGTH ${HEX_UPPER} HEX_LEN)
+    set(RESULT 0)
+    set(INDEX 0)
+    while(INDEX LESS HEX_LEN)
+        string(SUBSTRING ${HEX_UPPER} ${INDEX} 1 DIGIT)
+        string(FIND ${STM8_HEX_DIGITS} ${DIGIT} DIGIT_VALUE)
+        if(DIGIT_VALUE LESS 0)
+            message(FATAL_ERROR "Invalid hexadecimal number: ${HEX}")
+        endif()
+        math(EXPR RESULT "${RESULT} * 16 + ${DIGIT_VALUE}")
+        math(EXPR INDEX "${INDEX} + 1")
+    endwhile()
+    set(${DEC} ${RESULT} PARENT_SCOPE)
+endfunction()
+
+#Formats DEC as WIDTH hexadecimal digits (upper case, no prefix)
+function(STM8_DEC_TO_HEX DEC WIDTH HEX)
+    set(VALUE ${DEC})
+    set(RESULT "")
+    set(INDEX 0)
+    while(INDEX LESS WIDTH OR VALUE GREATER 0)
+        math(EXPR DIGIT_VALUE "${VALUE} % 16")
+        math(EXPR VALUE "${VALUE} / 16")
+        string(SUBSTRING ${STM8_HEX_DIGITS} ${DIGIT_VALUE} 1 DIGIT)
+        set(RESULT "${DIGIT}${RESULT}")
+        math(EXPR INDEX "${INDEX} + 1")
+    endwhile()
+    set(${HEX} ${RESULT} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,131 @@
+#Interrupt vector table of STM8_CHIP generated from the chip database (STM8_TYPE_<type>_IRQS)
+#
+#SDCC fills the vector table from the interrupt handlers declared in the file
+#with main(). STM8_ADD_VECTORS writes stm8_vectors.h, to be included there, and
+#stm8_vectors.c into ${CMAKE_CURRENT_BINARY_DIR}/stm8_vectors (one vector map
+#per directory) and returns the source in VECTOR_SOURCES:
+# - HANDLERS: <name>_IRQHandler() (stm8_it.h names) is defined by the
+#   application or a module and is the vector itself, no extra latency
+# - DISPATCH: the generated <name>_IRQHandler() calls the handler set at run
+#   time with Vectors_SetHandler(VECTORS_<name>, <function>)
+# - TRAP_UNUSED: the other vectors get a handler recording their number for
+#   Vectors_GetUnhandled(), instead of the SDCC default entry
+#Unused vectors are reported at configure time.
+#
+#STM8_ADD_VECTORS(<VECTOR_SOURCES> [HANDLERS <name>...] [DISPATCH <name>...] [TRAP_UNUSED])
+
+function(STM8_ADD_VECTORS VECTOR_SOURCES)
+    set(HANDLER_LIST "")
+    set(DISPATCH_LIST "")
+    set(TRAP FALSE)
+    set(LIST_NAME "")
+    foreach(ARG ${ARGN})
+        if(ARG STREQUAL "HANDLERS")
+            set(LIST_NAME HANDLER_LIST)
+        elseif(ARG STREQUAL "DISPATCH")
+            set(LIST_NAME DISPATCH_LIST)
+        elseif(ARG STREQUAL "TRAP_UNUSED")
+            set(TRAP TRUE)
+        elseif(LIST_NAME)
+            list(APPEND ${LIST_NAME} ${ARG})
+        else()
+            message(FATAL_ERROR "Unexpected argument of STM8_ADD_VECTORS: ${ARG}")
+        endif()
+    endforeach()
+
+    #Vector names and numbers of the chip
+    set(IRQ_NAMES "")
+    foreach(IRQ ${STM8_TYPE_${STM8_CHIP_TYPE}_IRQS})
+        string(REGEX REPLACE "^([0-9]+):(.+)$" "\\1" NUMBER ${IRQ})
+        string(REGEX REPLACE "^([0-9]+):(.+)$" "\\2" NAME ${IRQ})
+        list(APPEND IRQ_NAMES ${NAME})
+        set(IRQ_${NAME}_NUMBER ${NUMBER})
+    endforeach()
+    foreach(NAME ${HANDLER_LIST} ${DISPATCH_LIST})
+        list(FIND IRQ_NAMES ${NAME} INDEX)
+        if(INDEX EQUAL -1)
+            string(REPLACE ";" " " SUPPORTED "${IRQ_NAMES}")
+            message(FATAL_ERROR "${STM8_CHIP_NAME} has no interrupt vector ${NAME}. Vectors: ${SUPPORTED}")
+        endif()
+        if(IRQ_${NAME}_USED)
+            message(FATAL_ERROR "Interrupt vector ${NAME} is listed twice in STM8_ADD_VECTORS")
+        endif()
+        set(IRQ_${NAME}_USED TRUE)
+    endforeach()
+    set(UNUSED_LIST "")
+    foreach(NAME ${IRQ_NAMES})
+        if(NOT IRQ_${NAME}_USED)
+            list(APPEND UNUSED_LIST ${NAME})
+        endif()
+    endforeach()
+
+    #The parentheses around the names keep the stm8_it.h macros from expanding
+    set(HEADER "/* Interrupt vectors of ${STM8_CHIP_NAME}, generated by STM8_ADD_VECTORS (sdcc-stm8-vectors.cmake) */\n")
+    set(HEADER "${HEADER}\n#ifndef STM8_VECTORS_H_\n#define STM8_VECTORS_H_\n\n#include <stdint.h>\n")
+    set(SOURCE "#include \"stm8_vectors.h\"\n")
+
+    if(HANDLER_LIST)
+        set(HEADER "${HEADER}\n//Defined by the application or a module\n")
+        foreach(NAME ${HANDLER_LIST})
+            set(HEADER "${HEADER}void (${NAME}_IRQHandler)(void) __interrupt(${IRQ_${NAME}_NUMBER});\n")
+        endforeach()
+    endif()
+
+    if(DISPATCH_LIST OR TRAP)
+        set(HEADER "${HEADER}\n//Number of the last vector without handler, 0xFF for none\nuint8_t Vectors_GetUnhandled(void);\n")
+        set(SOURCE "${SOURCE}\nstatic volatile uint8_t Unhandled = 0xFF;\n\nuint8_t Vectors_GetUnhandled(void)\n{\n  return Unhandled;\n}\n")
+    endif()
+
+    if(DISPATCH_LIST)
+        set(HEADER "${HEADER}\n//Dispatched to the handler set with Vectors_SetHandler(), 0 for none\n")
+        set(HEADER "${HEADER}typedef void (*Vectors_Handler_TypeDef)(void);\n")
+        set(HEADER "${HEADER}void Vectors_SetHandler(uint8_t Index, Vectors_Handler_TypeDef Handler);\n")
+        set(INDEX 0)
+        foreach(NAME ${DISPATCH_LIST})
+            set(HEADER "${HEADER}#define VECTORS_${NAME} ${INDEX}\n")
+            math(EXPR INDEX "${INDEX} + 1")
+        endforeach()
+        foreach(NAME ${DISPATCH_LIST})
+            set(HEADER "${HEADER}void (${NAME}_IRQHandler)(void) __interrupt(${IRQ_${NAME}_NUMBER});\n")
+        endforeach()
+
+        set(SOURCE "${SOURCE}\nstatic Vectors_Handler_TypeDef Handlers[${INDEX}];\n")
+        set(SOURCE "${SOURCE}\n//Pointers are written in two bytes, the handler may be dispatched meanwhile\n")
+        set(SOURCE "${SOURCE}void Vectors_SetHandler(uint8_t Index, Vectors_Handler_TypeDef Handler)\n{\n")
+        set(SOURCE "${SOURCE}  __critical\n  {\n    Handlers[Index] = Handler;\n  }\n}\n")
+        foreach(NAME ${DISPATCH_LIST})
+            set(SOURCE "${SOURCE}\nvoid (${NAME}_IRQHandler)(void) __interrupt(${IRQ_${NAME}_NUMBER})\n{\n")
+            set(SOURCE "${SOURCE}  if (Handlers[VECTORS_${NAME}])\n  {\n    Handlers[VECTORS_${NAME}]();\n  }\n")
+            set(SOURCE "${SOURCE}  else\n  {\n    Unhandled = ${IRQ_${NAME}_NUMBER};\n  }\n}\n")
+        endforeach()
+    endif()
+
+    if(TRAP AND UNUSED_LIST)
+        set(HEADER "${HEADER}\n//Unused, recorded for Vectors_GetUnhandled()\n")
+        foreach(NAME ${UNUSED_LIST})
+            set(HEADER "${HEADER}void (${NAME}_IRQHandler)(void) __interrupt(${IRQ_${NAME}_NUMBER});\n")
+            set(SOURCE "${SOURCE}\nvoid (${NAME}_IRQHandler)(void) __interrupt(${IRQ_${NAME}_NUMBER})\n{\n")
+            set(SOURCE "${SOURCE}  Unhandled = ${IRQ_${NAME}_NUMBER};\n}\n")
+        endforeach()
+    endif()
+
+    set(HEADER "${HEADER}\n#endif //STM8_VECTORS_H_\n")
+
+    #Written through configure_file so unchanged files are not rebuilt
+    set(OUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/stm8_vectors)
+    file(WRITE ${OUT_DIR}/stm8_vectors.h.in "${HEADER}")
+    file(WRITE ${OUT_DIR}/stm8_vectors.c.in "${SOURCE}")
+    configure_file(${OUT_DIR}/stm8_vectors.h.in ${OUT_DIR}/stm8_vectors.h COPYONLY)
+    configure_file(${OUT_DIR}/stm8_vectors.c.in ${OUT_DIR}/stm8_vectors.c COPYONLY)
+    include_directories(${OUT_DIR})
+
+    list(LENGTH HANDLER_LIST HANDLER_COUNT)
+    list(LENGTH DISPATCH_LIST DISPATCH_COUNT)
+    string(REPLACE ";" " " UNUSED "${UNUSED_LIST}")
+    if(TRAP)
+        set(UNUSED "${UNUSED} (trapped)")
+    endif()
+    message(STATUS "${STM8_CHIP_NAME} vectors: ${HANDLER_COUNT} direct, ${DISPATCH_COUNT} dispatched, unused: ${UNUSED}")
+
+    set(${VECTOR_SOURCES} ${OUT_DIR}/stm8_vectors.c PARENT_SCOPE)
+endfunction()
@@ -20,15 +20,277 @@ endif()
 
 
 
+include(sdcc-stm8-utils)
+
+#Chip database, filled by the series module (sdcc-stm8s.cmake, sdcc-stm8l.cmake)
+#
+#STM8_ADD_CHIP_TYPE(<type> <StdPeriph define> <StdPeriph family> <density>
+#                   IRQS <vector>:<handler>... COMPONENTS <component>...)
+function(STM8_ADD_CHIP_TYPE TYPE DEFINE FAMILY DENSITY)
+    set(IRQ_LIST "")
+    set(COMPONENT_LIST "")
+    set(LIST_NAME "")
+    foreach(ARG ${ARGN})
+        if(ARG STREQUAL "IRQS")
+            set(LIST_NAME IRQ_LIST)
+        elseif(ARG STREQUAL "COMPONENTS")
+            set(LIST_NAME COMPONENT_LIST)
+        elseif(LIST_NAME)
+            list(APPEND ${LIST_NAME} ${ARG})
+        else()
+            message(FATAL_ERROR "Unexpected argument of chip type ${TYPE}: ${ARG}")
+        endif()
+    endforeach()
+    list(APPEND STM8_CHIP_TYPES ${TYPE})
+    set(STM8_CHIP_TYPES ${STM8_CHIP_TYPES} PARENT_SCOPE)
+    set(STM8_TYPE_${TYPE}_DEFINE ${DEFINE} PARENT_SCOPE)
+    set(STM8_TYPE_${TYPE}_FAMILY ${FAMILY} PARENT_SCOPE)
+    set(STM8_TYPE_${TYPE}_DENSITY ${DENSITY} PARENT_SCOPE)
+    set(STM8_TYPE_${TYPE}_IRQS ${IRQ_LIST} PARENT_SCOPE)
+    set(STM8_TYPE_${TYPE}_COMPONENTS ${COMPONENT_LIST} PARENT_SCOPE)
+endfunction()
+
+#STM8_ADD_CHIPS(<type> <flash size> <RAM size> <EEPROM size> <chip>...)
+function(STM8_ADD_CHIPS TYPE FLASH_SIZE RAM_SIZE EEPROM_SIZE)
+    list(FIND STM8_CHIP_TYPES ${TYPE} TYPE_INDEX)
+    if(TYPE_INDEX EQUAL -1)
+        message(FATAL_ERROR "Chips ${ARGN} use undefined chip type ${TYPE}")
+    endif()
+    foreach(CHIP ${ARGN})
+        list(APPEND STM8_CHIPS ${CHIP})
+        set(STM8_CHIP_${CHIP}_TYPE ${TYPE} PARENT_SCOPE)
+        set(STM8_CHIP_${CHIP}_FLASH_SIZE ${FLASH_SIZE} PARENT_SCOPE)
+        set(STM8_CHIP_${CHIP}_RAM_SIZE ${RAM_SIZE} PARENT_SCOPE)
+        set(STM8_CHIP_${CHIP}_EEPROM_SIZE ${EEPROM_SIZE} PARENT_SCOPE)
+    endforeach()
+    set(STM8_CHIPS ${STM8_CHIPS} PARENT_SCOPE)
+endfunction()
+
+set(STM8_CHIP_TYPES "")
+set(STM8_CHIPS "")
 string(TOLOWER ${STM8_SERIES} STM8_SERIES_LOWER)
 include(sdcc-stm8${STM8_SERIES_LOWER})
 
+#Database name of CHIP: upper case, package and temperature range suffix
+#removed (stm8s103f3p6 -> STM8S103F3). Unknown chips are a configuration error.
+function(STM8_GET_CHIP_NAME CHIP CHIP_NAME)
+    string(TOUPPER ${CHIP} CHIP_UPPER)
+    string(REGEX MATCH "^STM8[SL][0-9][0-9][0-9][A-Z][0-9A-Z]" RESULT ${CHIP_UPPER})
+    list(FIND STM8_CHIPS "${RESULT}" CHIP_INDEX)
+    if(CHIP_INDEX EQUAL -1)
+        string(REPLACE ";" " " SUPPORTED "${STM8_CHIPS}")
+        message(FATAL_ERROR "Invalid/unsupported STM8${STM8_SERIES} chip: ${CHIP}\n"
+                "Supported chips: ${SUPPORTED}")
+    endif()
+    set(${CHIP_NAME} ${RESULT} PARENT_SCOPE)
+endfunction()
+
+function(STM8_GET_CHIP_TYPE CHIP CHIP_TYPE)
+    STM8_GET_CHIP_NAME(${CHIP} CHIP_NAME)
+    set(${CHIP_TYPE} ${STM8_CHIP_${CHIP_NAME}_TYPE} PARENT_SCOPE)
+endfunction()
+
+function(STM8_GET_FLASH_SIZE CHIP FLASH_SIZE)
+    STM8_GET_CHIP_NAME(${CHIP} CHIP_NAME)
+    set(${FLASH_SIZE} ${STM8_CHIP_${CHIP_NAME}_FLASH_SIZE} PARENT_SCOPE)
+endfunction()
+
+function(STM8_GET_RAM_SIZE CHIP RAM_SIZE)
+    STM8_GET_CHIP_NAME(${CHIP} CHIP_NAME)
+    set(${RAM_SIZE} ${STM8_CHIP_${CHIP_NAME}_RAM_SIZE} PARENT_SCOPE)
+endfunction()
+
+function(STM8_GET_EEPROM_SIZE CHIP EEPROM_SIZE)
+    STM8_GET_CHIP_NAME(${CHIP} CHIP_NAME)
+    set(${EEPROM_SIZE} ${STM8_CHIP_${CHIP_NAME}_EEPROM_SIZE} PARENT_SCOPE)
+endfunction()
+
+if(STM8_CHIP)
+    STM8_GET_CHIP_NAME(${STM8_CHIP} STM8_CHIP_NAME)
+    set(STM8_CHIP_TYPE ${STM8_CHIP_${STM8_CHIP_NAME}_TYPE})
+    message(STATUS "STM8 chip: ${STM8_CHIP_NAME} (${STM8_TYPE_${STM8_CHIP_TYPE}_DEFINE}), "
+            "Flash ${STM8_CHIP_${STM8_CHIP_NAME}_FLASH_SIZE}, RAM ${STM8_CHIP_${STM8_CHIP_NAME}_RAM_SIZE}, "
+            "EEPROM ${STM8_CHIP_${STM8_CHIP_NAME}_EEPROM_SIZE} bytes")
+endif()
+
+set(STM8_CMAKE_DIR ${CMAKE_CURRENT_LIST_DIR} CACHE INTERNAL "stm8 cmake modules directory")
+
+set(STM8_STACK_SIZE 256 CACHE STRING "Bytes reserved for the stack at the top of RAM")
+set(STM8_RAM_SEG_SIZE 256 CACHE STRING "Bytes reserved for the RAM_SEG code segment (RAM execution)")
+set(STM8_FLASH_BUDGET "" CACHE STRING "Flash budget in bytes of the size targets (chip Flash size if empty)")
+set(STM8_RAM_BUDGET "" CACHE STRING "RAM budget in bytes of the size targets (chip RAM less stack if empty)")
+option(STM8_RAM_EXECUTION "Build the StdPeriph flash library for execution from RAM (RAM_SEG)" OFF)
+
+#Chip define, StdPeriph family (STM8_FAMILY_S, STM8_FAMILY_L10X, STM8_FAMILY_L15X)
+#and memory sizes of CHIP for the sources of TARGET
+function(STM8_SET_CHIP_DEFINITIONS TARGET CHIP)
+    STM8_GET_CHIP_NAME(${CHIP} CHIP_NAME)
+    set(CHIP_TYPE ${STM8_CHIP_${CHIP_NAME}_TYPE})
+    string(TOUPPER "STM8_FAMILY_${STM8_TYPE_${CHIP_TYPE}_FAMILY}" CHIP_FAMILY)
+    set(CHIP_DEFS
+            ${STM8_TYPE_${CHIP_TYPE}_DEFINE}
+            ${CHIP_FAMILY}
+            STM8_FLASH_SIZE=${STM8_CHIP_${CHIP_NAME}_FLASH_SIZE}
+            STM8_RAM_SIZE=${STM8_CHIP_${CHIP_NAME}_RAM_SIZE}
+            STM8_EEPROM_SIZE=${STM8_CHIP_${CHIP_NAME}_EEPROM_SIZE})
+    get_target_property(TARGET_DEFS ${TARGET} COMPILE_DEFINITIONS)
+    if(TARGET_DEFS)
+        set(TARGET_DEFS "${CHIP_DEFS};${TARGET_DEFS}")
+    else()
+        set(TARGET_DEFS "${CHIP_DEFS}")
+    endif()
+    set_target_properties(${TARGET} PROPERTIES COMPILE_DEFINITIONS "${TARGET_DEFS}")
+endfunction()
+
+#Lets the linker check the image against the Flash and RAM (less the stack) of CHIP
+function(STM8_SET_CHIP_LINK_FLAGS TARGET CHIP)
+    STM8_GET_FLASH_SIZE(${CHIP} FLASH_SIZE)
+    STM8_GET_RAM_SIZE(${CHIP} RAM_SIZE)
+    math(EXPR IRAM_SIZE "${RAM_SIZE} - ${STM8_STACK_SIZE}")
+    get_target_property(TARGET_LD_FLAGS ${TARGET} LINK_FLAGS)
+    if(TARGET_LD_FLAGS)
+        set(TARGET_LD_FLAGS "--code-size ${FLASH_SIZE} --iram-size ${IRAM_SIZE} ${TARGET_LD_FLAGS}")
+    else()
+        set(TARGET_LD_FLAGS "--code-size ${FLASH_SIZE} --iram-size ${IRAM_SIZE}")
+    endif()
+    set_target_properties(${TARGET} PROPERTIES LINK_FLAGS "${TARGET_LD_FLAGS}")
+endfunction()
+
 function(STM8_SET_TARGET_PROPERTIES TARGET)
-    if(NOT STM8_CHIP_TYPE)
-        STM8_GET_CHIP_TYPE(${STM8_CHIP} STM8_CHIP_TYPE)
+    if(NOT STM8_CHIP)
+        message(FATAL_ERROR "STM8_CHIP is not set")
+    endif()
+    STM8_SET_CHIP_DEFINITIONS(${TARGET} ${STM8_CHIP})
+    get_target_property(TARGET_TYPE ${TARGET} TYPE)
+    if(TARGET_TYPE STREQUAL "EXECUTABLE")
+        STM8_SET_CHIP_LINK_FLAGS(${TARGET} ${STM8_CHIP})
+    endif()
+endfunction()
+
+#RAM_SEG is linked below the stack and its image is stored at the end of the
+#first 64K of Flash (the loader uses 16-bit addressing)
+function(STM8_GET_RAM_SEGMENT_ADDRESSES RAM_SEG_ADDRESS RAM_SEG_LOAD)
+    STM8_GET_RAM_SIZE(${STM8_CHIP} RAM_SIZE)
+    STM8_GET_FLASH_SIZE(${STM8_CHIP} FLASH_SIZE)
+
+    math(EXPR ADDRESS "${RAM_SIZE} - ${STM8_STACK_SIZE} - ${STM8_RAM_SEG_SIZE}")
+    if(ADDRESS LESS 256)
+        message(FATAL_ERROR "STM8_RAM_SEG_SIZE and STM8_STACK_SIZE don't fit in ${RAM_SIZE} bytes of RAM")
+    endif()
+    math(EXPR FLASH_END "32768 + ${FLASH_SIZE}")
+    if(FLASH_END GREATER 65536)
+        set(FLASH_END 65536)
     endif()
-    STM8_SET_CHIP_DEFINITIONS(${TARGET} ${STM8_CHIP_TYPE})
+    math(EXPR LOAD "${FLASH_END} - ${STM8_RAM_SEG_SIZE}")
+
+    STM8_DEC_TO_HEX(${ADDRESS} 4 ADDRESS_HEX)
+    STM8_DEC_TO_HEX(${LOAD} 4 LOAD_HEX)
+    set(${RAM_SEG_ADDRESS} 0x${ADDRESS_HEX} PARENT_SCOPE)
+    set(${RAM_SEG_LOAD} 0x${LOAD_HEX} PARENT_SCOPE)
 endfunction()
 
+#Builds SOURCES a second time into the RAM_SEG code segment (RAM_SEG_BUILD pass)
+#and returns them in RAM_SOURCES, together with the RAM_SEG loader
+function(STM8_ADD_RAM_SEGMENT RAM_SOURCES)
+    STM8_GET_RAM_SEGMENT_ADDRESSES(RAM_SEG_ADDRESS RAM_SEG_LOAD)
+    set(RESULT "")
+    foreach(SRC ${ARGN})
+        get_filename_component(SRC_PATH ${SRC} ABSOLUTE)
+        get_filename_component(SRC_NAME ${SRC} NAME_WE)
+        set(RAM_SRC ${CMAKE_CURRENT_BINARY_DIR}/ram_seg/${SRC_NAME}_ram.c)
+        file(WRITE ${RAM_SRC}.in "#include \"${SRC_PATH}\"\n")
+        configure_file(${RAM_SRC}.in ${RAM_SRC} COPYONLY)
+        set_source_files_properties(${RAM_SRC} PROPERTIES
+                COMPILE_FLAGS "--codeseg RAM_SEG"
+                COMPILE_DEFINITIONS RAM_SEG_BUILD)
+        list(APPEND RESULT ${RAM_SRC})
+    endforeach()
+
+    set(LOADER ${STM8_StdPeriph_COMMON_DIR}/stm8_ram.c)
+    set_source_files_properties(${LOADER} PROPERTIES
+            COMPILE_DEFINITIONS "RAM_SEG_LOAD=${RAM_SEG_LOAD};RAM_SEG_STARTUP")
+    list(APPEND RESULT ${LOADER})
+    set(${RAM_SOURCES} ${RESULT} PARENT_SCOPE)
+endfunction()
+
+#Enables RAM_EXECUTION for TARGET, links RAM_SEG at its RAM address and moves
+#its image to the Flash load address after linking
+function(STM8_SET_RAM_SEGMENT_PROPERTIES TARGET)
+    STM8_GET_RAM_SEGMENT_ADDRESSES(RAM_SEG_ADDRESS RAM_SEG_LOAD)
+
+    get_target_property(TARGET_DEFS ${TARGET} COMPILE_DEFINITIONS)
+    if(TARGET_DEFS)
+        set(TARGET_DEFS "RAM_EXECUTION;${TARGET_DEFS}")
+    else()
+        set(TARGET_DEFS "RAM_EXECUTION")
+    endif()
+    set_target_properties(${TARGET} PROPERTIES COMPILE_DEFINITIONS "${TARGET_DEFS}")
+
+    get_target_property(TARGET_LD_FLAGS ${TARGET} LINK_FLAGS)
+    if(TARGET_LD_FLAGS)
+        #Data stays below RAM_SEG and code leaves room for its load area
+        STM8_HEX_TO_DEC(${RAM_SEG_ADDRESS} IRAM_SIZE)
+        string(REGEX REPLACE "--iram-size [0-9]+" "--iram-size ${IRAM_SIZE}" TARGET_LD_FLAGS "${TARGET_LD_FLAGS}")
+        STM8_GET_FLASH_SIZE(${STM8_CHIP} FLASH_SIZE)
+        math(EXPR CODE_SIZE "${FLASH_SIZE} - ${STM8_RAM_SEG_SIZE}")
+        string(REGEX REPLACE "--code-size [0-9]+" "--code-size ${CODE_SIZE}" TARGET_LD_FLAGS "${TARGET_LD_FLAGS}")
+        set(TARGET_LD_FLAGS "-Wl-bRAM_SEG=${RAM_SEG_ADDRESS} ${TARGET_LD_FLAGS}")
+    else()
+        set(TARGET_LD_FLAGS "-Wl-bRAM_SEG=${RAM_SEG_ADDRESS}")
+    endif()
+    set_target_properties(${TARGET} PROPERTIES LINK_FLAGS "${TARGET_LD_FLAGS}")
+
+    add_custom_command(TARGET ${TARGET} POST_BUILD
+            COMMAND ${CMAKE_COMMAND}
+                -DIHX_FILE=$<TARGET_FILE:${TARGET}>
+                -DRAM_SEG_ADDRESS=${RAM_SEG_ADDRESS}
+                -DRAM_SEG_LOAD=${RAM_SEG_LOAD}
+                -DRAM_SEG_SIZE=${STM8_RAM_SEG_SIZE}
+                -P ${STM8_CMAKE_DIR}/sdcc-stm8-ramseg.cmake
+            COMMENT "Moving RAM_SEG of ${TARGET} to ${RAM_SEG_LOAD}")
+endfunction()
+
+#Adds <TARGET>_size, built with ALL: reports Flash and RAM usage of TARGET per
+#area, module and function (<TARGET>.size) and fails when a budget is exceeded.
+#STM8_ADD_SIZE_TARGET(<target> [FLASH_BUDGET <bytes>] [RAM_BUDGET <bytes>])
+function(STM8_ADD_SIZE_TARGET TARGET)
+    STM8_GET_FLASH_SIZE(${STM8_CHIP} FLASH_SIZE)
+    STM8_GET_RAM_SIZE(${STM8_CHIP} RAM_SIZE)
+    set(TARGET_FLASH_BUDGET ${STM8_FLASH_BUDGET})
+    set(TARGET_RAM_BUDGET ${STM8_RAM_BUDGET})
+    if(NOT TARGET_FLASH_BUDGET)
+        set(TARGET_FLASH_BUDGET ${FLASH_SIZE})
+    endif()
+    if(NOT TARGET_RAM_BUDGET)
+        math(EXPR TARGET_RAM_BUDGET "${RAM_SIZE} - ${STM8_STACK_SIZE}")
+    endif()
+
+    set(BUDGET_NAME "")
+    foreach(ARG ${ARGN})
+        if(ARG STREQUAL "FLASH_BUDGET")
+            set(BUDGET_NAME TARGET_FLASH_BUDGET)
+        elseif(ARG STREQUAL "RAM_BUDGET")
+            set(BUDGET_NAME TARGET_RAM_BUDGET)
+        elseif(BUDGET_NAME)
+            set(${BUDGET_NAME} ${ARG})
+            set(BUDGET_NAME "")
+        else()
+            message(FATAL_ERROR "Unexpected argument of STM8_ADD_SIZE_TARGET(${TARGET}): ${ARG}")
+        endif()
+    endforeach()
+
+    add_custom_target(${TARGET}_size ALL
+            COMMAND ${CMAKE_COMMAND}
+                -DIHX_FILE=$<TARGET_FILE:${TARGET}>
+                -DREPORT_FILE=$<TARGET_FILE_DIR:${TARGET}>/${TARGET}.size
+                -DFLASH_SIZE=${FLASH_SIZE}
+                -DRAM_SIZE=${RAM_SIZE}
+                -DSTACK_SIZE=${STM8_STACK_SIZE}
+                -DFLASH_BUDGET=${TARGET_FLASH_BUDGET}
+                -DRAM_BUDGET=${TARGET_RAM_BUDGET}
+                -P ${STM8_CMAKE_DIR}/sdcc-stm8-size.cmake
+            DEPENDS ${TARGET}
+            COMMENT "Checking size of ${TARGET}")
+endfunction()
 
 #TODO: add hex target
\ No newline at end of file
@@ -1,50 +1,119 @@
-set(STM8_CHIP_TYPES
-        10X
-        15X_LD
-        15X_MD
-        15X_MDP
-        15X_HD
-        05X_LD_VL
-        05X_MD_VL
-        05X_HD_VL)
-
-
-set(STM8_CODES
-        101[FGK][23]
-        151[CFGK][23]
-        15[12][CGK][46]
-        15[12][R][6]
-        1[56][12][CMR][8]
-        051[F][3]
-        052[C][6]
-        052[R][8]
-    )
-
-macro(STM8_GET_CHIP_TYPE CHIP CHIP_TYPE)
-    string(TOUPPER ${CHIP} CHIP_UPPER)
-    string(REGEX REPLACE "^[sS][tT][mM]8[lL]( ([01][056][12][CFGKMR]) )+$" "\\1" STM8_CODE ${CHIP_UPPER})
-    set(INDEX 0)
-    foreach(TYPE ${STM8_CHIP_TYPES})
-        list(GET STM8_CODES ${INDEX} CHIP_TYPE_REGEX)
-        if(STM8_CODE MATCHES ${CHIP_TYPE_REGEX})
-            set(RESULT_TYPE ${TYPE})
-        endif()
-        MATH(EXPR INDEX "${INDEX}+1")
-    endforeach()
-    set(${CHIP_TYPE} ${RESULT_TYPE})
-endmacro()
-
-
-function(STM8_SET_CHIP_DEFINITIONS TARGET CHIP_TYPE)
-    list(FIND STM8_CHIP_TYPES ${CHIP_TYPE} TYPE_INDEX)
-    if(TYPE_INDEX EQUAL -1)
-        message(FATAL_ERROR "Invalid/unsupported STM8L chip type: ${CHIP_TYPE}")
-    endif()
-    get_target_property(TARGET_DEFS ${TARGET} COMPILE_DEFINITIONS)
-    if(TARGET_DEFS)
-        set(TARGET_DEFS "STM8L${CHIP_TYPE};${TARGET_DEFS}")
-    else()
-        set(TARGET_DEFS "STM8L${CHIP_TYPE}")
-    endif()
-    set_target_properties(${TARGET} PROPERTIES COMPILE_DEFINITIONS "${TARGET_DEFS}")
-endfunction()
\ No newline at end of file
+#STM8L chip database, see STM8_ADD_CHIP_TYPE and STM8_ADD_CHIPS in sdcc-stm8.cmake
+
+#Interrupt vectors, <vector>:<handler name without _IRQHandler> (stm8_it.h)
+set(STM8L_IRQS_10X
+        1:FLASH
+        4:AWU
+        6:EXTIB
+        7:EXTID
+        8:EXTI0
+        9:EXTI1
+        10:EXTI2
+        11:EXTI3
+        12:EXTI4
+        13:EXTI5
+        14:EXTI6
+        15:EXTI7
+        18:COMP
+        19:TIM2_UPD_OVF_TRG_BRK
+        20:TIM2_CAP
+        21:TIM3_UPD_OVF_TRG_BRK
+        22:TIM3_CAP
+        25:TIM4_UPD_OVF
+        26:SPI
+        27:USART_TX
+        28:USART_RX
+        29:I2C
+        )
+
+set(STM8L_IRQS_15X_COMMON
+        1:FLASH
+        2:DMA1_CHANNEL0_1
+        3:DMA1_CHANNEL2_3
+        4:RTC
+        8:EXTI0
+        9:EXTI1
+        10:EXTI2
+        11:EXTI3
+        12:EXTI4
+        13:EXTI5
+        14:EXTI6
+        15:EXTI7
+        18:ADC1_COMP
+        19:TIM2_UPD_OVF_TRG_BRK
+        20:TIM2_CAP_COM
+        21:TIM3_UPD_OVF_TRG_BRK
+        22:TIM3_CAP_COM
+        25:TIM4_UPD_OVF_TRG
+        26:SPI1
+        27:USART1_TX
+        28:USART1_RX
+        29:I2C
+        )
+
+set(STM8L_IRQS_15X_LD
+        ${STM8L_IRQS_15X_COMMON}
+        5:EXTIE_F_PVD
+        6:EXTIB
+        7:EXTID
+        17:CLK_CSS
+        23:RI
+        )
+
+set(STM8L_IRQS_15X_MD
+        ${STM8L_IRQS_15X_COMMON}
+        5:EXTIE_F_PVD
+        6:EXTIB_G
+        7:EXTID_H
+        16:LCD
+        17:CLK_TIM1_DAC
+        23:TIM1_OVF_TRG_COM
+        24:TIM1_CAP_COM
+        )
+
+set(STM8L_IRQS_05X_LD_VL
+        ${STM8L_IRQS_15X_COMMON}
+        5:PVD
+        6:EXTIB
+        7:EXTID
+        17:CLK_CSS
+        23:RI
+        )
+
+#StdPeriph components available on each chip type
+set(STM8L_COMPONENTS_10X
+        awu beep clk comp exti flash gpio i2c irtim itc iwdg rst spi tim2 tim3 tim4 usart wfe)
+set(STM8L_COMPONENTS_15X_LD
+        adc beep clk comp dma exti flash gpio i2c irtim itc iwdg pwr rst rtc spi syscfg tim2 tim3 tim4 usart wfe wwdg)
+set(STM8L_COMPONENTS_15X_MD ${STM8L_COMPONENTS_15X_LD} dac lcd tim1)
+set(STM8L_COMPONENTS_15X_MDP ${STM8L_COMPONENTS_15X_MD} tim5)
+set(STM8L_COMPONENTS_15X_HD ${STM8L_COMPONENTS_15X_MDP})
+set(STM8L_COMPONENTS_16X_HD ${STM8L_COMPONENTS_15X_HD} aes)
+set(STM8L_COMPONENTS_05X_LD_VL ${STM8L_COMPONENTS_15X_LD})
+list(REMOVE_ITEM STM8L_COMPONENTS_05X_LD_VL comp)
+set(STM8L_COMPONENTS_05X_MD_VL ${STM8L_COMPONENTS_05X_LD_VL} lcd tim1)
+set(STM8L_COMPONENTS_05X_HD_VL ${STM8L_COMPONENTS_05X_MD_VL} tim5)
+
+STM8_ADD_CHIP_TYPE(10X       STM8L10X       L10x LD  IRQS ${STM8L_IRQS_10X}       COMPONENTS ${STM8L_COMPONENTS_10X})
+STM8_ADD_CHIP_TYPE(15X_LD    STM8L15X_LD    L15x LD  IRQS ${STM8L_IRQS_15X_LD}    COMPONENTS ${STM8L_COMPONENTS_15X_LD})
+STM8_ADD_CHIP_TYPE(15X_MD    STM8L15X_MD    L15x MD  IRQS ${STM8L_IRQS_15X_MD}    COMPONENTS ${STM8L_COMPONENTS_15X_MD})
+STM8_ADD_CHIP_TYPE(15X_MDP   STM8L15X_MDP   L15x MDP IRQS ${STM8L_IRQS_15X_MD}    COMPONENTS ${STM8L_COMPONENTS_15X_MDP})
+STM8_ADD_CHIP_TYPE(15X_HD    STM8L15X_HD    L15x HD  IRQS ${STM8L_IRQS_15X_MD}    COMPONENTS ${STM8L_COMPONENTS_15X_HD})
+STM8_ADD_CHIP_TYPE(16X_HD    STM8L15X_HD    L15x HD  IRQS ${STM8L_IRQS_15X_MD}    COMPONENTS ${STM8L_COMPONENTS_16X_HD})
+STM8_ADD_CHIP_TYPE(05X_LD_VL STM8L05X_LD_VL L15x LD  IRQS ${STM8L_IRQS_05X_LD_VL} COMPONENTS ${STM8L_COMPONENTS_05X_LD_VL})
+STM8_ADD_CHIP_TYPE(05X_MD_VL STM8L05X_MD_VL L15x MD  IRQS ${STM8L_IRQS_15X_MD}    COMPONENTS ${STM8L_COMPONENTS_05X_MD_VL})
+STM8_ADD_CHIP_TYPE(05X_HD_VL STM8L05X_HD_VL L15x HD  IRQS ${STM8L_IRQS_15X_MD}    COMPONENTS ${STM8L_COMPONENTS_05X_HD_VL})
+
+#Memory sizes in bytes: Flash RAM EEPROM. STM8L10x data EEPROM is an area of the Flash.
+STM8_ADD_CHIPS(10X       4096  1536 0    STM8L101F2 STM8L101G2 STM8L101K2)
+STM8_ADD_CHIPS(10X       8192  1536 0    STM8L101F3 STM8L101G3 STM8L101K3)
+STM8_ADD_CHIPS(15X_LD    4096  1024 256  STM8L151C2 STM8L151F2 STM8L151G2 STM8L151K2)
+STM8_ADD_CHIPS(15X_LD    8192  1024 256  STM8L151C3 STM8L151F3 STM8L151G3 STM8L151K3)
+STM8_ADD_CHIPS(15X_MD    16384 2048 1024 STM8L151C4 STM8L151G4 STM8L151K4 STM8L152C4 STM8L152K4)
+STM8_ADD_CHIPS(15X_MD    32768 2048 1024 STM8L151C6 STM8L151G6 STM8L151K6 STM8L152C6 STM8L152K6)
+STM8_ADD_CHIPS(15X_MDP   32768 2048 1024 STM8L151R6 STM8L152R6)
+STM8_ADD_CHIPS(15X_HD    65536 4096 2048 STM8L151C8 STM8L151M8 STM8L151R8 STM8L152C8 STM8L152M8 STM8L152R8)
+STM8_ADD_CHIPS(16X_HD    65536 4096 2048 STM8L162M8 STM8L162R8)
+STM8_ADD_CHIPS(05X_LD_VL 8192  1024 256  STM8L051F3)
+STM8_ADD_CHIPS(05X_MD_VL 32768 2048 256  STM8L052C6)
+STM8_ADD_CHIPS(05X_HD_VL 65536 4096 256  STM8L052R8)
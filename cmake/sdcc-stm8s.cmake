@@ -1,49 +1,118 @@
-set(STM8_CHIP_TYPES
-        208
-        207
-        007
-        105
-        005
-        103
-        003
-        903)
-
-set(STM8_CODES
-        208[CMRS][68B]
-        207[CKMRS][68B]
-        007[C][8]
-        105[CKS][46]
-        005[CK][6]
-        103[FK][23]
-        003[FK][3]
-        903[FK][3]
+#STM8S chip database, see STM8_ADD_CHIP_TYPE and STM8_ADD_CHIPS in sdcc-stm8.cmake
+
+#Interrupt vectors, <vector>:<handler name without _IRQHandler> (stm8_it.h)
+set(STM8S_IRQS_COMMON
+        0:TLI
+        1:AWU
+        2:CLK
+        3:EXTI_PORTA
+        4:EXTI_PORTB
+        5:EXTI_PORTC
+        6:EXTI_PORTD
+        7:EXTI_PORTE
+        )
+
+set(STM8S_IRQS_208
+        ${STM8S_IRQS_COMMON}
+        8:CAN_RX
+        9:CAN_TX
+        10:SPI
+        11:TIM1_UPD_OVF_TRG_BRK
+        12:TIM1_CAP_COM
+        13:TIM2_UPD_OVF
+        14:TIM2_CAP_COM
+        15:TIM3_UPD_OVF
+        16:TIM3_CAP_COM
+        17:UART1_TX
+        18:UART1_RX
+        19:I2C
+        20:UART3_TX
+        21:UART3_RX
+        22:ADC2
+        23:TIM4_UPD_OVF
+        24:FLASH
+        )
+
+set(STM8S_IRQS_207 ${STM8S_IRQS_208})
+list(REMOVE_ITEM STM8S_IRQS_207 8:CAN_RX 9:CAN_TX)
+
+set(STM8S_IRQS_105
+        ${STM8S_IRQS_COMMON}
+        10:SPI
+        11:TIM1_UPD_OVF_TRG_BRK
+        12:TIM1_CAP_COM
+        13:TIM2_UPD_OVF
+        14:TIM2_CAP_COM
+        15:TIM3_UPD_OVF
+        16:TIM3_CAP_COM
+        19:I2C
+        20:UART2_TX
+        21:UART2_RX
+        22:ADC1
+        23:TIM4_UPD_OVF
+        24:FLASH
         )
 
-macro(STM8_GET_CHIP_TYPE CHIP CHIP_TYPE)
-    string(TOUPPER ${CHIP} CHIP_UPPER)
-    string(REGEX REPLACE "^[sS][tT][mM]8[sS]( ([0129][0][3578][CFKMRS][23468B]) )+$" "\\1" STM8_CODE ${CHIP_UPPER})
-    set(INDEX 0)
-    foreach(TYPE ${STM8_CHIP_TYPES})
-        list(GET STM8_CODES ${INDEX} CHIP_TYPE_REGEX)
-        if(STM8_CODE MATCHES ${CHIP_TYPE_REGEX})
-            set(RESULT_TYPE ${TYPE})
-        endif()
-        MATH(EXPR INDEX "${INDEX}+1")
-    endforeach()
-    set(${CHIP_TYPE} ${RESULT_TYPE})
-endmacro()
-
-
-function(STM8_SET_CHIP_DEFINITIONS TARGET CHIP_TYPE)
-    list(FIND STM8_CHIP_TYPES ${CHIP_TYPE} TYPE_INDEX)
-    if(TYPE_INDEX EQUAL -1)
-        message(FATAL_ERROR "Invalid/unsupported STM8L chip type: ${CHIP_TYPE}")
-    endif()
-    get_target_property(TARGET_DEFS ${TARGET} COMPILE_DEFINITIONS)
-    if(TARGET_DEFS)
-        set(TARGET_DEFS "STM8L${CHIP_TYPE};${TARGET_DEFS}")
-    else()
-        set(TARGET_DEFS "STM8L${CHIP_TYPE}")
-    endif()
-    set_target_properties(${TARGET} PROPERTIES COMPILE_DEFINITIONS "${TARGET_DEFS}")
-endfunction()
\ No newline at end of file
+set(STM8S_IRQS_103
+        ${STM8S_IRQS_COMMON}
+        10:SPI
+        11:TIM1_UPD_OVF_TRG_BRK
+        12:TIM1_CAP_COM
+        13:TIM2_UPD_OVF
+        14:TIM2_CAP_COM
+        17:UART1_TX
+        18:UART1_RX
+        19:I2C
+        22:ADC1
+        23:TIM4_UPD_OVF
+        24:FLASH
+        )
+
+set(STM8S_IRQS_903
+        ${STM8S_IRQS_COMMON}
+        8:EXTI_PORTF
+        10:SPI
+        11:TIM1_UPD_OVF_TRG_BRK
+        12:TIM1_CAP_COM
+        13:TIM5_UPD_OVF_TRG
+        14:TIM5_CAP_COM
+        17:UART1_TX
+        18:UART1_RX
+        19:I2C
+        22:ADC2
+        23:TIM6_UPD_OVF
+        24:FLASH
+        )
+
+#StdPeriph components available on each chip type
+set(STM8S_COMPONENTS_COMMON awu beep clk exti flash gpio i2c itc iwdg rst spi tim1 wwdg)
+set(STM8S_COMPONENTS_208 ${STM8S_COMPONENTS_COMMON} adc2 can tim2 tim3 tim4 uart1 uart3)
+set(STM8S_COMPONENTS_207 ${STM8S_COMPONENTS_COMMON} adc2 tim2 tim3 tim4 uart1 uart3)
+set(STM8S_COMPONENTS_105 ${STM8S_COMPONENTS_COMMON} adc1 tim2 tim3 tim4 uart2)
+set(STM8S_COMPONENTS_103 ${STM8S_COMPONENTS_COMMON} adc1 tim2 tim4 uart1)
+set(STM8S_COMPONENTS_903 ${STM8S_COMPONENTS_COMMON} adc1 tim5 tim6 uart1)
+
+STM8_ADD_CHIP_TYPE(208 STM8S208 S HD IRQS ${STM8S_IRQS_208} COMPONENTS ${STM8S_COMPONENTS_208})
+STM8_ADD_CHIP_TYPE(207 STM8S207 S HD IRQS ${STM8S_IRQS_207} COMPONENTS ${STM8S_COMPONENTS_207})
+STM8_ADD_CHIP_TYPE(007 STM8S007 S HD IRQS ${STM8S_IRQS_207} COMPONENTS ${STM8S_COMPONENTS_207})
+STM8_ADD_CHIP_TYPE(105 STM8S105 S MD IRQS ${STM8S_IRQS_105} COMPONENTS ${STM8S_COMPONENTS_105})
+STM8_ADD_CHIP_TYPE(005 STM8S005 S MD IRQS ${STM8S_IRQS_105} COMPONENTS ${STM8S_COMPONENTS_105})
+STM8_ADD_CHIP_TYPE(103 STM8S103 S LD IRQS ${STM8S_IRQS_103} COMPONENTS ${STM8S_COMPONENTS_103})
+STM8_ADD_CHIP_TYPE(003 STM8S003 S LD IRQS ${STM8S_IRQS_103} COMPONENTS ${STM8S_COMPONENTS_103})
+STM8_ADD_CHIP_TYPE(903 STM8S903 S LD IRQS ${STM8S_IRQS_903} COMPONENTS ${STM8S_COMPONENTS_903})
+
+#Memory sizes in bytes: Flash RAM EEPROM
+STM8_ADD_CHIPS(208 32768  6144 1024 STM8S208C6 STM8S208M6 STM8S208R6 STM8S208S6)
+STM8_ADD_CHIPS(208 65536  6144 2048 STM8S208C8 STM8S208M8 STM8S208R8 STM8S208S8)
+STM8_ADD_CHIPS(208 131072 6144 2048 STM8S208CB STM8S208MB STM8S208RB STM8S208SB)
+STM8_ADD_CHIPS(207 32768  6144 1024 STM8S207C6 STM8S207K6 STM8S207M6 STM8S207R6 STM8S207S6)
+STM8_ADD_CHIPS(207 65536  6144 2048 STM8S207C8 STM8S207K8 STM8S207M8 STM8S207R8 STM8S207S8)
+STM8_ADD_CHIPS(207 131072 6144 2048 STM8S207CB STM8S207KB STM8S207MB STM8S207RB STM8S207SB)
+STM8_ADD_CHIPS(007 65536  6144 128  STM8S007C8)
+STM8_ADD_CHIPS(105 16384  2048 1024 STM8S105C4 STM8S105K4 STM8S105S4)
+STM8_ADD_CHIPS(105 32768  2048 1024 STM8S105C6 STM8S105K6 STM8S105S6)
+STM8_ADD_CHIPS(005 32768  2048 128  STM8S005C6 STM8S005K6)
+STM8_ADD_CHIPS(103 4096   1024 640  STM8S103F2 STM8S103K2)
+STM8_ADD_CHIPS(103 8192   1024 640  STM8S103F3 STM8S103K3)
+STM8_ADD_CHIPS(003 8192   1024 128  STM8S003F3 STM8S003K3)
+STM8_ADD_CHIPS(903 8192   1024 640  STM8S903F3 STM8S903K3)
@@ -0,0 +1,17 @@
+#include "bench.h"
+#include <stm8s_adc1.h>
+
+static uint16_t Samples[10];
+
+void BENCH_Setup(void)
+{
+}
+
+/* One call per data buffer register */
+void BENCH_Run(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < 10; i++)
+        Samples[i] = ADC1_GetBufferValue(i);
+}
@@ -0,0 +1,13 @@
+#include "bench.h"
+#include <stm8s_adc1.h>
+
+static uint16_t Samples[10];
+
+void BENCH_Setup(void)
+{
+}
+
+void BENCH_Run(void)
+{
+    ADC1_GetBufferValues(Samples, 10);
+}
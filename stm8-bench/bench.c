@@ -0,0 +1,10 @@
+#include "bench.h"
+
+void main(void)
+{
+    BENCH_Setup();
+    BENCH_Start();
+    BENCH_Run();
+    BENCH_Stop();
+    while(1);
+}
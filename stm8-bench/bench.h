@@ -0,0 +1,30 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*
+ * Cycle count benchmarks run under ucsim (see STM8_ADD_BENCHMARK in
+ * sdcc-stm8-bench.cmake)
+ *
+ * Every benchmark image calls BENCH_Setup(), then BENCH_Run() between the
+ * BENCH_Start() and BENCH_Stop() markers. The simulator stops at both markers
+ * and the cycles in between, less those of the empty benchmark, are reported.
+ */
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x.h>
+#elif defined(STM8_FAMILY_L10X)
+#include <stm8l10x.h>
+#else
+#error "STM8_FAMILY_<family> is not defined, see STM8_SET_TARGET_PROPERTIES"
+#endif
+
+void BENCH_Start(void);
+void BENCH_Stop(void);
+
+//Defined by each benchmark
+void BENCH_Setup(void);
+void BENCH_Run(void);
+
+#endif //BENCH_H_
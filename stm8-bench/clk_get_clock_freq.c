@@ -0,0 +1,18 @@
+#include "bench.h"
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s_clk.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x_clk.h>
+#else
+#include <stm8l10x_clk.h>
+#endif
+
+void BENCH_Setup(void)
+{
+}
+
+void BENCH_Run(void)
+{
+    CLK_GetClockFreq();
+}
@@ -0,0 +1,10 @@
+#include "bench.h"
+
+/* Calibration: cost of the markers, subtracted from the other benchmarks */
+void BENCH_Setup(void)
+{
+}
+
+void BENCH_Run(void)
+{
+}
@@ -0,0 +1,21 @@
+#include "bench.h"
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s_flash.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x_flash.h>
+#else
+#include <stm8l10x_flash.h>
+#endif
+
+volatile uint8_t Value;
+
+void BENCH_Setup(void)
+{
+}
+
+/* Start of the program memory on all families */
+void BENCH_Run(void)
+{
+    Value = FLASH_ReadByte(0x8000);
+}
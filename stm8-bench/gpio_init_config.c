@@ -0,0 +1,23 @@
+#include "bench.h"
+#include <stm8_config.h>
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s_gpio.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x_gpio.h>
+#else
+#include <stm8l10x_gpio.h>
+#endif
+
+void BENCH_Setup(void)
+{
+}
+
+void BENCH_Run(void)
+{
+#if defined(STM8_FAMILY_S)
+    GPIO_CONFIG(GPIOC, GPIO_PIN_7, GPIO_MODE_OUT_PP_LOW_FAST);
+#else
+    GPIO_CONFIG(GPIOC, GPIO_Pin_7, GPIO_Mode_Out_PP_Low_Fast);
+#endif
+}
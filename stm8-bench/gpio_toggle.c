@@ -0,0 +1,22 @@
+#include "bench.h"
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s_gpio.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x_gpio.h>
+#else
+#include <stm8l10x_gpio.h>
+#endif
+
+void BENCH_Setup(void)
+{
+}
+
+void BENCH_Run(void)
+{
+#if defined(STM8_FAMILY_S)
+    GPIO_WriteReverse(GPIOC, GPIO_PIN_7);
+#else
+    GPIO_ToggleBits(GPIOC, GPIO_Pin_7);
+#endif
+}
@@ -0,0 +1,22 @@
+#include "bench.h"
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s_i2c.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x_i2c.h>
+#else
+#include <stm8l10x_i2c.h>
+#endif
+
+void BENCH_Setup(void)
+{
+}
+
+void BENCH_Run(void)
+{
+#if defined(STM8_FAMILY_L15X)
+    I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_MODE_SELECT);
+#else
+    I2C_CheckEvent(I2C_EVENT_MASTER_MODE_SELECT);
+#endif
+}
@@ -0,0 +1,13 @@
+#include "bench.h"
+#include <stm8_priority.h>
+
+void BENCH_Setup(void)
+{
+}
+
+//Priority section around shared data, compare with a sim/rim pair
+void BENCH_Run(void)
+{
+    uint8_t state = Priority_Raise(PRIORITY_LEVEL_2);
+    Priority_Restore(state);
+}
@@ -0,0 +1,37 @@
+#include "bench.h"
+
+#if defined(STM8_FAMILY_S)
+#include <stm8s_clk.h>
+#include <stm8s_uart1.h>
+#elif defined(STM8_FAMILY_L15X)
+#include <stm8l15x_clk.h>
+#include <stm8l15x_usart.h>
+#else
+#include <stm8l10x_clk.h>
+#include <stm8l10x_usart.h>
+#endif
+
+void BENCH_Setup(void)
+{
+#if defined(STM8_FAMILY_S)
+    CLK_PeripheralClockConfig(CLK_PERIPHERAL_UART1, ENABLE);
+#elif defined(STM8_FAMILY_L15X)
+    CLK_PeripheralClockConfig(CLK_Peripheral_USART1, ENABLE);
+#else
+    CLK_PeripheralClockConfig(CLK_Peripheral_USART, ENABLE);
+#endif
+}
+
+void BENCH_Run(void)
+{
+#if defined(STM8_FAMILY_S)
+    UART1_Init(115200, UART1_WORDLENGTH_8D, UART1_STOPBITS_1, UART1_PARITY_NO,
+               UART1_SYNCMODE_CLOCK_DISABLE, UART1_MODE_TXRX_ENABLE);
+#elif defined(STM8_FAMILY_L15X)
+    USART_Init(USART1, 115200, USART_WordLength_8b, USART_StopBits_1, USART_Parity_No,
+               (USART_Mode_TypeDef)(USART_Mode_Tx | USART_Mode_Rx));
+#else
+    USART_Init(115200, USART_WordLength_8D, USART_StopBits_1, USART_Parity_No,
+               (USART_Mode_TypeDef)(USART_Mode_Tx | USART_Mode_Rx));
+#endif
+}
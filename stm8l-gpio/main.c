@@ -1,10 +1,34 @@
 #include <stm8l15x.h>
+#include <stm8l15x_clk.h>
 #include <stm8l15x_gpio.h>
+#include <stm8_scheduler.h>
+
+//TIM4 update every 128 * 156 cycles of the 2 MHz default clock: 10 ms
+#define TICKS_PER_SECOND 100
+
+static uint8_t GreenTask;
+static uint8_t BlueTask;
+
+static void Green(void) {
+    GPIO_ToggleBits(GPIOE, GPIO_Pin_7);
+    Scheduler_Delay(GreenTask, TICKS_PER_SECOND);
+}
+
+static void Blue(void) {
+    GPIO_ToggleBits(GPIOC, GPIO_Pin_7);
+    Scheduler_Delay(BlueTask, TICKS_PER_SECOND / 2);
+}
 
 void main() {
     GPIO_Init(GPIOC, GPIO_Pin_7, GPIO_Mode_Out_PP_Low_Fast);
     GPIO_Init(GPIOE, GPIO_Pin_7, GPIO_Mode_Out_PP_Low_Fast);
-    GPIO_ToggleBits(GPIOC, GPIO_Pin_7);
-    GPIO_ToggleBits(GPIOE, GPIO_Pin_7);
-    while(1);
-}
\ No newline at end of file
+
+    CLK_PeripheralClockConfig(CLK_Peripheral_TIM4, ENABLE);
+    Scheduler_Init(TIM4_Prescaler_128, 155);
+    GreenTask = Scheduler_Add(Green);
+    BlueTask = Scheduler_Add(Blue);
+    Scheduler_Post(GreenTask);
+    Scheduler_Post(BlueTask);
+    //Sleeps in wfi between the toggles
+    Scheduler_Run();
+}